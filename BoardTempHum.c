@@ -17,6 +17,7 @@
 #include "peripheral_drivers/gpio/gpio_driver.h"
 #include "peripheral_drivers/i2c/i2c_driver.h"
 #include "board_drivers/hardware_def.h"
+#include "profile.h"
 
 #include <iib_modules/fap.h>
 #include <iib_modules/fac_os.h>
@@ -141,6 +142,8 @@ void RelativeHumidityRead(void)
 
 //*******************************************************************************************
 
+    PROFILE_START(PROFILE_RH_LINEARIZE);
+
     rawHumidity = RelHumValue;
 
     curve = (rawHumidity/16.0)-24.0;
@@ -151,6 +154,8 @@ void RelativeHumidityRead(void)
 
     RelativeHumidity.Value = linearHumidity;
 
+    PROFILE_STOP(PROFILE_RH_LINEARIZE);
+
 //*******************************************************************************************
 
     if(RelativeHumidity.Value > RelativeHumidity.AlarmLimit)
@@ -265,6 +270,13 @@ void BoardTempDelay(unsigned int delay_ms)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+void BoardTempItlkEnable(unsigned char sts)
+{
+    TemperatureBoard.ItlkEnable = sts;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 unsigned char BoardTempAlarmStatusRead(void)
 {
 #if (BoardTempEnable == 1)
@@ -284,7 +296,7 @@ unsigned char BoardTempTripStatusRead(void)
 {
 #if (BoardTempEnable == 1)
 
-    return TemperatureBoard.Trip;
+    return TemperatureBoard.Trip && TemperatureBoard.ItlkEnable;
 
 #else
 
@@ -317,6 +329,13 @@ void RhDelay(unsigned int delay_ms)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+void RhItlkEnable(unsigned char sts)
+{
+    RelativeHumidity.ItlkEnable = sts;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 unsigned char RhAlarmStatusRead(void)
 {
 #if (RhEnable == 1)
@@ -336,7 +355,7 @@ unsigned char RhTripStatusRead(void)
 {
 #if (RhEnable == 1)
 
-    return RelativeHumidity.Trip;
+    return RelativeHumidity.Trip && RelativeHumidity.ItlkEnable;
 
 #else
 
@@ -13,6 +13,7 @@ typedef struct
     float TripLimit;
     unsigned char Alarm;
     unsigned char Trip;
+    unsigned char ItlkEnable;
     unsigned int  Alarm_Delay_ms; // milisecond
     unsigned int  Alarm_DelayCount;
     unsigned int  Itlk_Delay_ms; // milisecond
@@ -45,6 +46,7 @@ extern void BoardTempTripLevelSet(float nValue);
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 extern void BoardTempDelay(unsigned int delay_ms);
+extern void BoardTempItlkEnable(unsigned char sts);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -59,6 +61,7 @@ extern void RhTripLevelSet(float nValue);
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 extern void RhDelay(unsigned int delay_ms);
+extern void RhItlkEnable(unsigned char sts);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
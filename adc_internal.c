@@ -10,6 +10,9 @@
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 #include "adc_internal.h"
+#include "capture.h"
+#include "adc_rms.h"
+#include "trip_latency.h"
 
 #include <iib_modules/fap.h>
 #include <iib_modules/fac_os.h>
@@ -49,6 +52,48 @@ static uint32_t adc_1_value[7];
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+// Canais na ordem de adc_0_value[] e adc_1_value[]. DriverVolt e unipolar e
+// nao tem offset de meio de escala para calibrar.
+static adc_t * const cal_channel[ADC_NUM_CHANNELS] =
+{
+    &VoltageCh1, &VoltageCh2, &VoltageCh3, &VoltageCh4,
+    &LvCurrentCh1, &LvCurrentCh2, &LvCurrentCh3,
+    &CurrentCh1, &CurrentCh2, &CurrentCh3, &CurrentCh4,
+    0, &Driver2Curr, &Driver1Curr
+};
+
+static uint32_t cal_sum[ADC_NUM_CHANNELS];
+static uint16_t cal_measured[ADC_NUM_CHANNELS];
+
+static volatile uint16_t cal_count = 0;
+static volatile uint16_t cal_accepted = 0;
+static volatile unsigned char cal_running = 0;
+static volatile unsigned char cal_done = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#if (AdcInjectEnable == 1)
+
+// Onda quadrada por canal: low, high e meio periodo em ms (0 = sempre low)
+typedef struct
+{
+    uint16_t low;
+    uint16_t high;
+    uint16_t half_period_ms;
+    uint16_t code;
+} adc_inject_t;
+
+static adc_inject_t inject[ADC_NUM_CHANNELS];
+
+static volatile uint16_t inject_mask = 0;
+
+#endif
+
+// Amostras de 1ms desde a ultima programacao da injecao (tempo da bancada)
+static volatile uint32_t inject_ticks = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 void AdcsInit(void)
 {
     // Disable ADC0 and ADC1 peripheral
@@ -119,6 +164,81 @@ void AdcsInit(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+static void adc_calibration_sample(void)
+{
+    unsigned char i;
+    uint32_t mean;
+
+    for(i = 0; i < 7; i++)
+    {
+        cal_sum[i] += adc_0_value[i];
+        cal_sum[i + 7] += adc_1_value[i];
+    }
+
+    cal_count++;
+
+    if(cal_count < ADC_CAL_SAMPLES) return;
+
+    // Offsets fora da tolerancia indicam sinal presente ou sensor ausente
+    for(i = 0; i < ADC_NUM_CHANNELS; i++)
+    {
+        mean = (cal_sum[i] + ADC_CAL_SAMPLES / 2) / ADC_CAL_SAMPLES;
+
+        cal_measured[i] = mean;
+
+        if(cal_channel[i] == 0) continue;
+
+        if(mean >= ADC_CAL_MIDSCALE - ADC_CAL_TOLERANCE && mean <= ADC_CAL_MIDSCALE + ADC_CAL_TOLERANCE)
+        {
+            cal_channel[i]->Offset = mean;
+            cal_accepted |= (1 << i);
+        }
+    }
+
+    cal_running = 0;
+    cal_done = 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#if (AdcInjectEnable == 1)
+
+static void adc_inject_apply(void)
+{
+    unsigned char i;
+    uint16_t code;
+    adc_inject_t *w;
+
+    inject_ticks++;
+
+    for(i = 0; i < ADC_NUM_CHANNELS; i++)
+    {
+        if(!(inject_mask & (1 << i))) continue;
+
+        w = &inject[i];
+
+        code = w->low;
+
+        if(w->half_period_ms && ((inject_ticks / w->half_period_ms) & 1)) code = w->high;
+
+        // Cada borda arma a medicao da latencia de trip com o debounce do canal
+        if(code != w->code)
+        {
+            w->code = code;
+            TripLatencyStep(i, cal_channel[i] ? cal_channel[i]->Itlk_Delay_us : 0);
+        }
+
+        if(i < 7) adc_0_value[i] = code;
+        else adc_1_value[i - 7] = code;
+    }
+
+    TripLatencyTripCheck();
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 void sample_adc(void)
 {
 
@@ -146,6 +266,28 @@ void sample_adc(void)
     // Read ADC Value.
     ADCSequenceDataGet(ADC1_BASE, 0, adc_1_value);
 
+#if (AdcInjectEnable == 1)
+
+    // Formas de onda programadas substituem a leitura antes de qualquer consumidor
+    if(inject_mask) adc_inject_apply();
+
+    // Replay de uma captura gravada, sobre as mesmas leituras
+    CaptureReplay(adc_0_value, adc_1_value);
+
+#endif
+
+    // Registro das formas de onda para analise pos-interlock
+    CaptureSample(adc_0_value, adc_1_value);
+
+#if (AdcRmsEnable == 1)
+
+    // RMS e ripple dos canais selecionados, na taxa plena da aquisicao
+    AdcRmsSample(adc_0_value, adc_1_value);
+
+#endif
+
+    if(cal_running) adc_calibration_sample();
+
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -1851,8 +1993,137 @@ void AdcClearAlarmTrip(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+void AdcCalibrationStart(void)
+{
+    unsigned char i;
+
+    if(cal_running) return;
+
+    for(i = 0; i < ADC_NUM_CHANNELS; i++)
+    {
+        cal_sum[i] = 0;
+        cal_measured[i] = 0;
+    }
+
+    cal_count = 0;
+    cal_accepted = 0;
+    cal_done = 0;
+
+    cal_running = 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char AdcCalibrationBusy(void)
+{
+    return cal_running;
+}
 
+/////////////////////////////////////////////////////////////////////////////////////////////
 
+unsigned char AdcCalibrationDone(void)
+{
+    unsigned char done = cal_done;
 
+    cal_done = 0;
 
+    return done;
+}
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char AdcCalibrationResult(unsigned char ch, unsigned int *measured)
+{
+    if(ch >= ADC_NUM_CHANNELS) return 0;
+
+    *measured = cal_measured[ch];
+
+    return (cal_accepted >> ch) & 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+adc_t *AdcInputChannel(unsigned char input)
+{
+    if(input >= ADC_NUM_CHANNELS) return 0;
+
+    return cal_channel[input];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char AdcInjectSet(unsigned char ch, unsigned int low, unsigned int high)
+{
+#if (AdcInjectEnable == 1)
+
+    if(ch >= ADC_NUM_CHANNELS) return 0;
+
+    // Uma entrada por vez: a medicao da latencia acompanha um so canal
+    if(inject_mask & ~(1 << ch)) return 0;
+
+    inject_mask &= ~(1 << ch);
+
+    inject[ch].low = low;
+    inject[ch].high = high;
+
+    // A primeira amostra aplica o nivel baixo sem armar a medicao
+    inject[ch].code = low;
+
+    inject_ticks = 0;
+
+    inject_mask |= (1 << ch);
+
+    return 1;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcInjectPeriod(unsigned char ch, unsigned int half_period_ms)
+{
+#if (AdcInjectEnable == 1)
+
+    if(ch >= ADC_NUM_CHANNELS) return;
+
+    inject[ch].half_period_ms = half_period_ms;
+
+    inject_ticks = 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcInjectRelease(unsigned char ch)
+{
+#if (AdcInjectEnable == 1)
+
+    if(ch < ADC_NUM_CHANNELS) inject_mask &= ~(1 << ch);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcInjectClear(void)
+{
+#if (AdcInjectEnable == 1)
+
+    inject_mask = 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t AdcInjectTicks(void)
+{
+    return inject_ticks;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
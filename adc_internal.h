@@ -6,6 +6,40 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Entradas do ADC interno (adc_0_value[] e adc_1_value[])
+#define ADC_NUM_CHANNELS                        14
+
+#define ADC_INPUT_VOLTAGE_CH1                   0
+#define ADC_INPUT_VOLTAGE_CH2                   1
+#define ADC_INPUT_VOLTAGE_CH3                   2
+#define ADC_INPUT_VOLTAGE_CH4                   3
+#define ADC_INPUT_LV_CURRENT_CH1                4
+#define ADC_INPUT_LV_CURRENT_CH2                5
+#define ADC_INPUT_LV_CURRENT_CH3                6
+#define ADC_INPUT_CURRENT_CH1                   7
+#define ADC_INPUT_CURRENT_CH2                   8
+#define ADC_INPUT_CURRENT_CH3                   9
+#define ADC_INPUT_CURRENT_CH4                   10
+#define ADC_INPUT_DRIVER_VOLTAGE                11
+#define ADC_INPUT_DRIVER2_CURRENT               12
+#define ADC_INPUT_DRIVER1_CURRENT               13
+
+// Calibracao de zero: media de ADC_CAL_SAMPLES amostras de 1ms por canal
+// Tolerancia de +-64 codigos (1,6% do fundo de escala) em torno do meio
+#define ADC_CAL_SAMPLES                         2048
+#define ADC_CAL_MIDSCALE                        0x0800
+#define ADC_CAL_TOLERANCE                       64
+
+// 1: leituras do ADC interno podem ser substituidas por formas de onda
+// programadas pelo CAN (somente firmware de bancada)
+#define AdcInjectEnable                         0
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 typedef struct
 {
     unsigned char Ch;
@@ -254,6 +288,22 @@ extern void AdcClearAlarmTrip(void);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+extern void AdcCalibrationStart(void);
+extern unsigned char AdcCalibrationBusy(void);
+extern unsigned char AdcCalibrationDone(void);
+extern unsigned char AdcCalibrationResult(unsigned char ch, unsigned int *measured);
+extern adc_t *AdcInputChannel(unsigned char input);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern unsigned char AdcInjectSet(unsigned char ch, unsigned int low, unsigned int high);
+extern void AdcInjectPeriod(unsigned char ch, unsigned int half_period_ms);
+extern void AdcInjectRelease(unsigned char ch);
+extern void AdcInjectClear(void);
+extern uint32_t AdcInjectTicks(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 #endif
 
 /////////////////////////////////////////////////////////////////////////////////////////////
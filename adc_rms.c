@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file adc_rms.c
+ * @brief True-RMS and peak-to-peak ripple of selected internal ADC inputs.
+ *
+ * AdcRmsSample() runs in the 1ms interrupt right after the conversions. Per
+ * sample it only does integer work: a 12-bit code minus the offset squares to
+ * less than 2^24, so a 64-bit sum holds any window the parameter allows. The
+ * float conversion and the square root happen once per window.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "adc_rms.h"
+#include "adc_internal.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+adc_rms_t AdcRms[ADC_RMS_SLOTS];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Canal de cada slot; 0 = slot livre
+static adc_t *slot_channel[ADC_RMS_SLOTS];
+static uint8_t slot_input[ADC_RMS_SLOTS];
+
+static uint64_t sum_sq[ADC_RMS_SLOTS];
+static uint16_t code_min[ADC_RMS_SLOTS];
+static uint16_t code_max[ADC_RMS_SLOTS];
+static uint32_t samples[ADC_RMS_SLOTS];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcRmsInit(uint8_t slot, uint8_t input, unsigned int window_ms)
+{
+    if(slot >= ADC_RMS_SLOTS) return;
+
+    slot_channel[slot] = 0;
+
+    samples[slot] = 0;
+
+    AdcRms[slot].Window_ms = window_ms;
+    AdcRms[slot].Rms = 0.0;
+    AdcRms[slot].Ripple = 0.0;
+    AdcRms[slot].RmsAlarm = 0;
+    AdcRms[slot].RippleAlarm = 0;
+    AdcRms[slot].RmsAlarm_DelayCount = 0;
+    AdcRms[slot].RippleAlarm_DelayCount = 0;
+
+    slot_input[slot] = input;
+
+    // Entradas sem canal (DriverVolt nao tem offset) ficam de fora
+    slot_channel[slot] = AdcInputChannel(input);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcRmsAlarmLevelSet(uint8_t slot, float rms, float ripple)
+{
+    if(slot >= ADC_RMS_SLOTS) return;
+
+    AdcRms[slot].RmsAlarmLimit = rms;
+    AdcRms[slot].RippleAlarmLimit = ripple;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcRmsAlarmDelay(uint8_t slot, unsigned int delay_ms)
+{
+    if(slot >= ADC_RMS_SLOTS) return;
+
+    AdcRms[slot].Alarm_Delay_ms = delay_ms;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcRmsSample(const uint32_t *adc_0, const uint32_t *adc_1)
+{
+    uint8_t i;
+    uint16_t code;
+    int32_t delta;
+    adc_rms_t *s;
+
+    for(i = 0; i < ADC_RMS_SLOTS; i++)
+    {
+        s = &AdcRms[i];
+
+        if(slot_channel[i] == 0 || s->Window_ms == 0) continue;
+
+        if(slot_input[i] < 7) code = adc_0[slot_input[i]];
+        else code = adc_1[slot_input[i] - 7];
+
+        delta = (int32_t)code - (int32_t)slot_channel[i]->Offset;
+
+        if(samples[i] == 0)
+        {
+            sum_sq[i] = 0;
+            code_min[i] = code;
+            code_max[i] = code;
+        }
+        else
+        {
+            if(code < code_min[i]) code_min[i] = code;
+            if(code > code_max[i]) code_max[i] = code;
+        }
+
+        sum_sq[i] += (uint32_t)(delta * delta);
+
+        if(++samples[i] < s->Window_ms) continue;
+
+        s->Rms = sqrtf((float)sum_sq[i] / (float)samples[i]) * slot_channel[i]->Gain;
+        s->Ripple = (float)(code_max[i] - code_min[i]) * slot_channel[i]->Gain;
+
+        // Mesmo debounce dos alarmes dos canais, contado em janelas
+        if(s->RmsAlarmLimit > 0.0 && s->Rms > s->RmsAlarmLimit)
+        {
+            if(s->RmsAlarm_DelayCount < s->Alarm_Delay_ms) s->RmsAlarm_DelayCount += s->Window_ms;
+            else
+            {
+               s->RmsAlarm_DelayCount = 0;
+               s->RmsAlarm = 1;
+            }
+        }
+        else s->RmsAlarm_DelayCount = 0;
+
+        if(s->RippleAlarmLimit > 0.0 && s->Ripple > s->RippleAlarmLimit)
+        {
+            if(s->RippleAlarm_DelayCount < s->Alarm_Delay_ms) s->RippleAlarm_DelayCount += s->Window_ms;
+            else
+            {
+               s->RippleAlarm_DelayCount = 0;
+               s->RippleAlarm = 1;
+            }
+        }
+        else s->RippleAlarm_DelayCount = 0;
+
+        samples[i] = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float AdcRmsRead(uint8_t slot)
+{
+    if(slot >= ADC_RMS_SLOTS) return 0.0;
+
+    return AdcRms[slot].Rms;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float AdcRippleRead(uint8_t slot)
+{
+    if(slot >= ADC_RMS_SLOTS) return 0.0;
+
+    return AdcRms[slot].Ripple;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char AdcRmsAlarmStatusRead(uint8_t slot)
+{
+    if(slot >= ADC_RMS_SLOTS) return 0;
+
+    return AdcRms[slot].RmsAlarm;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char AdcRippleAlarmStatusRead(uint8_t slot)
+{
+    if(slot >= ADC_RMS_SLOTS) return 0;
+
+    return AdcRms[slot].RippleAlarm;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdcRmsClearAlarm(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < ADC_RMS_SLOTS; i++)
+    {
+        AdcRms[i].RmsAlarm = 0;
+        AdcRms[i].RippleAlarm = 0;
+        AdcRms[i].RmsAlarm_DelayCount = 0;
+        AdcRms[i].RippleAlarm_DelayCount = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
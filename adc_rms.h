@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file adc_rms.h
+ * @brief True-RMS and peak-to-peak ripple of selected internal ADC inputs.
+ *
+ * Each slot follows one ADC input (ADC_INPUT_*) at the full acquisition rate
+ * of sample_adc(), 1 sample per ms. The offset-removed codes are squared into
+ * an integer sum and the min/max codes are tracked; when Window_ms samples
+ * are in, RMS = sqrt(sum / n) * Gain and ripple = (max - min) * Gain, both in
+ * the units of the channel. The default window of 100 ms holds 5 periods of
+ * 50 Hz and 6 of 60 Hz, so the mains ripple does not beat against the window.
+ *
+ * Like the alarms of the ADC channels, a result over RmsAlarmLimit /
+ * RippleAlarmLimit must hold for Alarm_Delay_ms (counted in whole windows;
+ * 0 = the first window) before the slot alarm is set, a window under the
+ * limit restarts the count, and the alarm stays set until AdcRmsClearAlarm()
+ * on the interlock reset. A limit of 0 disables it. Window and limits of
+ * every slot are runtime parameters (parameters.h).
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ADC_RMS_H_
+#define ADC_RMS_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define AdcRmsEnable                            1
+
+#define ADC_RMS_SLOTS                           4
+
+// Janela padrao em amostras de 1ms; 0 desliga o slot
+#define ADC_RMS_WINDOW_MS                       100
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    unsigned int Window_ms;
+    float RmsAlarmLimit;
+    float RippleAlarmLimit;
+    float Rms;
+    float Ripple;
+    unsigned char RmsAlarm;
+    unsigned char RippleAlarm;
+    unsigned int  Alarm_Delay_ms;  // milisecond
+    unsigned int  RmsAlarm_DelayCount;
+    unsigned int  RippleAlarm_DelayCount;
+}adc_rms_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern adc_rms_t AdcRms[ADC_RMS_SLOTS];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void AdcRmsInit(uint8_t slot, uint8_t input, unsigned int window_ms);
+extern void AdcRmsAlarmLevelSet(uint8_t slot, float rms, float ripple);
+extern void AdcRmsAlarmDelay(uint8_t slot, unsigned int delay_ms);
+extern void AdcRmsSample(const uint32_t *adc_0, const uint32_t *adc_1);
+extern float AdcRmsRead(uint8_t slot);
+extern float AdcRippleRead(uint8_t slot);
+extern unsigned char AdcRmsAlarmStatusRead(uint8_t slot);
+extern unsigned char AdcRippleAlarmStatusRead(uint8_t slot);
+extern void AdcRmsClearAlarm(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* ADC_RMS_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -10,6 +10,19 @@
 #include "leds.h"
 #include "can_bus.h"
 #include "input.h"
+#include "telemetry.h"
+#include "capture.h"
+#include "config_store.h"
+#include "profile.h"
+#include "trip_latency.h"
+#include "first_fault.h"
+#include "fault_log.h"
+#include "adc_rms.h"
+#include "igbt_thermal.h"
+#include "temp_slope.h"
+#include "dew_point.h"
+#include "plausibility.h"
+#include "iib_data.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include "fac_cmd.h"
@@ -29,6 +42,7 @@ unsigned char Alarm = 0;
 
 void AppConfiguration(void)
 {
+    config_status_t config;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -36,6 +50,10 @@ void AppConfiguration(void)
 
     config_module_fap();
 
+    TelemetryInit(fap_telemetry_cfg, FAP_NUM_SIGNALS);
+
+    CaptureInit(FAP_CAPTURE_CHANNELS, CAPTURE_PRE_TRIGGER, CAPTURE_POST_TRIGGER);
+
 #endif
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +62,10 @@ void AppConfiguration(void)
 
     config_module_fac_os();
 
+    TelemetryInit(fac_os_telemetry_cfg, FAC_OS_NUM_SIGNALS);
+
+    CaptureInit(FAC_OS_CAPTURE_CHANNELS, CAPTURE_PRE_TRIGGER, CAPTURE_POST_TRIGGER);
+
 #endif
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +74,10 @@ void AppConfiguration(void)
 
     config_module_fac_is();
 
+    TelemetryInit(fac_is_telemetry_cfg, FAC_IS_NUM_SIGNALS);
+
+    CaptureInit(FAC_IS_CAPTURE_CHANNELS, CAPTURE_PRE_TRIGGER, CAPTURE_POST_TRIGGER);
+
 #endif
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -60,8 +86,32 @@ void AppConfiguration(void)
 
     config_module_fac_cmd();
 
+    TelemetryInit(fac_cmd_telemetry_cfg, FAC_CMD_NUM_SIGNALS);
+
+    CaptureInit(FAC_CMD_CAPTURE_CHANNELS, CAPTURE_PRE_TRIGGER, CAPTURE_POST_TRIGGER);
+
 #endif
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    TempSlopeInit();
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Calibracao e limites gravados na EEPROM substituem os valores padrao
+    // Offsets gravados tem prioridade: a calibracao de boot so roda sem imagem
+    // valida; depois disso apenas pelo PARAM_CMD_CALIBRATE seguido de SAVE
+    config = ConfigLoad();
+
+    if(config != CONFIG_LOADED && config != CONFIG_PARTIAL)
+    {
+        // Zero dos canais com o estagio de potencia desligado, antes do ReleAuxTurnOn()
+        AdcCalibrationStart();
+    }
+
+    // Log de eventos na mesma EEPROM, apos a imagem de configuracao
+    FaultLogInit();
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     // End of configuration
@@ -90,11 +140,20 @@ void InterlockClear(void)
 
 void InterlockSet(void)
 {
+    if(!Interlock) CaptureEvent(CAPTURE_EVENT_INTERLOCK);
+
     Interlock = 1;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+unsigned char InterlockRead(void)
+{
+    return Interlock;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 void InterlockClearCheck(void)
 {
     if(ItlkClrCmd)
@@ -106,9 +165,14 @@ void InterlockClearCheck(void)
         InitApp = 0;
 
         AdcClearAlarmTrip();
+        AdcRmsClearAlarm();
         Pt100ClearAlarmTrip();
         RhBoardTempClearAlarmTrip();
         TempIgbt1TempIgbt2ClearAlarmTrip();
+        IgbtThermalClearAlarmTrip();
+        TempSlopeClearAlarmTrip();
+        DewPointClearAlarmTrip();
+        PlausibilityClearAlarm();
 
         ItlkClrCmd = 0;
 
@@ -148,6 +212,8 @@ void InterlockClearCheck(void)
 
 #endif
 
+        FirstFaultClear();
+
     }
 
 }
@@ -211,6 +277,8 @@ void AlarmClear(void)
 
 void AlarmSet(void)
 {
+    if(!Alarm) CaptureEvent(CAPTURE_EVENT_ALARM);
+
     Alarm = 1;
 }
 
@@ -220,6 +288,8 @@ void InterlockAppCheck(void)
 {
     unsigned char test = 0;
 
+    PROFILE_START(PROFILE_ITLK_CHECK);
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 #ifdef FAP
@@ -254,11 +324,13 @@ void InterlockAppCheck(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+    PROFILE_STOP(PROFILE_ITLK_CHECK);
+
     if(test)
     {
         InterlockSet();
 
-        send_itlk_message(0);
+        FirstFaultItlkSend(0);
     }
 }
 
@@ -306,7 +378,7 @@ void AlarmAppCheck(void)
     {
         AlarmSet();
 
-        send_alarm_message(0);
+        FirstFaultAlarmSend(0);
     }
 }
 
@@ -386,17 +458,28 @@ void Application(void)
 
 #endif
 
+    // Registra a ordem em que os bits aparecem, antes de qualquer acao sobre eles
+    FirstFaultUpdate(g_controller_iib.iib_itlk[0].u32, g_controller_iib.iib_alarm[0].u32);
+
+    FaultLogUpdate(g_controller_iib.iib_itlk[0].u32, g_controller_iib.iib_alarm[0].u32);
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+    // O primeiro bit de interlock congela a captura das formas de onda
+    if(g_controller_iib.iib_itlk[0].u32) CaptureTrigger();
+
     // Interlock Test
     if(Interlock == 1 && InterlockOld == 0)
     {
         InterlockOld = 1;
         AppInterlock();
+        TripLatencyRelayOff();
+        CaptureEvent(CAPTURE_EVENT_RELAY_OFF);
     }
 
     // Actions that needs to be taken during the Application initialization
-    if(InitApp == 0 && Interlock == 0)
+    // (aguarda a calibracao de zero dos ADCs)
+    if(InitApp == 0 && Interlock == 0 && !AdcCalibrationBusy())
     {
         InitApp = 1;
 
@@ -447,69 +530,6 @@ void Application(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-void send_data_schedule()
-{
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-#ifdef FAP
-
-    static uint8_t i = 0;
-
-    send_data_message(i);
-
-    i++;
-
-    if (i > 13) i = 0;
-
-#endif
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-#ifdef FAC_OS
-
-    static uint8_t i = 0;
-
-    send_data_message(i);
-
-    i++;
-
-    if (i > 12) i = 0;
-
-#endif
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-#ifdef FAC_IS
-
-    static uint8_t i = 0;
-
-    send_data_message(i);
-
-    i++;
-
-    if (i > 8) i = 0;
-
-#endif
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-#ifdef FAC_CMD
-
-    static uint8_t i = 0;
-
-    send_data_message(i);
-
-    i++;
-
-    if (i > 9) i = 0;
-
-#endif
-
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
 void power_on_check()
 {
 
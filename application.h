@@ -72,6 +72,7 @@ void InterlockClear(void);
 void InterlockSet(void);
 void InterlockClearCheck(void);
 void AppInterlock(void);
+unsigned char InterlockRead(void);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -89,7 +90,6 @@ void Application(void);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-extern void send_data_schedule();
 extern void power_on_check();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
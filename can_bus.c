@@ -20,8 +20,14 @@
 #include "application.h"
 #include "adc_internal.h"
 #include "leds.h"
+#include "capture.h"
+#include "parameters.h"
+#include "can_health.h"
+#include "trip_latency.h"
+#include "first_fault.h"
 #include "board_drivers/hardware_def.h"
 #include "peripheral_drivers/gpio/gpio_driver.h"
+#include "peripheral_drivers/can/can_hal.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -46,12 +52,18 @@ tCANMsgObject tx_message_alarm_iib;
 
 tCANMsgObject tx_message_param_iib;
 
+tCANMsgObject tx_message_capture_iib;
+
+tCANMsgObject tx_message_diag_iib;
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 tCANMsgObject rx_message_reset_udc;
 
 tCANMsgObject rx_message_param_udc;
 
+tCANMsgObject rx_message_capture_udc;
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 uint8_t message_data_iib[MESSAGE_DATA_IIB_LEN];
@@ -62,11 +74,19 @@ uint8_t message_alarm_iib[MESSAGE_ALARM_IIB_LEN];
 
 uint8_t message_param_iib[MESSAGE_PARAM_IIB_LEN];
 
+uint8_t message_capture_iib[MESSAGE_CAPTURE_IIB_LEN];
+
+uint8_t message_diag_iib[MESSAGE_DIAG_IIB_LEN];
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-uint8_t message_reset_udc[MESSAGE_RESET_UDC_LEN];
+// Fila de recepcao: a interrupcao so escreve rx_head, o loop principal so rx_tail
+static can_rx_frame_t rx_queue[CAN_RX_QUEUE_SIZE];
 
-uint8_t message_param_udc[MESSAGE_PARAM_UDC_LEN];
+static volatile uint8_t rx_head = 0;
+static volatile uint8_t rx_tail = 0;
+
+static volatile uint32_t rx_overflow = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -74,6 +94,29 @@ volatile uint8_t can_address    = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+static void can_rx_push(uint32_t obj_id, tCANMsgObject *msg)
+{
+    uint8_t next = (rx_head + 1) & (CAN_RX_QUEUE_SIZE - 1);
+
+    // A posicao rx_head nunca esta em uso pelo consumidor, mesmo com a fila cheia.
+    // O objeto e sempre lido para liberar o buffer do controlador.
+    msg->pui8MsgData = rx_queue[rx_head].data;
+
+    can_hal_message_get(obj_id, msg);
+
+    if(next == rx_tail)
+    {
+        rx_overflow++;
+        return;
+    }
+
+    rx_queue[rx_head].obj_id = obj_id;
+
+    rx_head = next;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 //*****************************************************************************
 //
 // This function is the interrupt handler for the CAN peripheral.  It checks
@@ -86,7 +129,7 @@ void can_isr(void)
     uint32_t ui32Status;
 
     // Read the CAN interrupt status to find the cause of the interrupt
-    ui32Status = CANIntStatus(CAN0_BASE, CAN_INT_STS_CAUSE);
+    ui32Status = can_hal_int_cause();
 
     // If the cause is a controller status interrupt, then get the status
     if(ui32Status == CAN_INT_INTID_STATUS)
@@ -99,7 +142,10 @@ void can_isr(void)
         // CAN peripheral is not connected to a CAN bus with other CAN devices
         // present, then errors will occur and will be indicated in the
         // controller status.
-        ui32Status = CANStatusGet(CAN0_BASE, CAN_STS_CONTROL);
+        ui32Status = can_hal_status();
+
+        // Contadores de erro, error-passive e bus-off
+        CanHealthStatus(ui32Status);
 
         // Set a flag to indicate some errors may have occurred.
         g_bErrFlag = 1;
@@ -115,9 +161,9 @@ void can_isr(void)
         // message object 1, and the message TX is complete.
         // Clear the message object interrupt.
 
-        CANIntClear(CAN0_BASE, MESSAGE_DATA_IIB_OBJ_ID);
+        can_hal_int_clear(MESSAGE_DATA_IIB_OBJ_ID);
 
-        /* Tx object 1. Nothing to do for now. */
+        CanHealthTxDone(MESSAGE_DATA_IIB_OBJ_ID);
 
         // Since the message was sent, clear any error flags.
         g_bErrFlag = 0;
@@ -133,9 +179,13 @@ void can_isr(void)
         // message object 2, and the message TX is complete.
         // Clear the message object interrupt.
 
-        CANIntClear(CAN0_BASE, MESSAGE_ITLK_IIB_OBJ_ID);
+        can_hal_int_clear(MESSAGE_ITLK_IIB_OBJ_ID);
+
+        CanHealthTxDone(MESSAGE_ITLK_IIB_OBJ_ID);
 
-        /* Tx object 2. Nothing to do for now. */
+        TripLatencyFrameSent();
+
+        CaptureEvent(CAPTURE_EVENT_ITLK_FRAME);
 
         // Since the message was sent, clear any error flags.
         g_bErrFlag = 0;
@@ -151,9 +201,11 @@ void can_isr(void)
         // message object 3, and the message TX is complete.
         // Clear the message object interrupt.
 
-        CANIntClear(CAN0_BASE, MESSAGE_ALARM_IIB_OBJ_ID);
+        can_hal_int_clear(MESSAGE_ALARM_IIB_OBJ_ID);
+
+        CanHealthTxDone(MESSAGE_ALARM_IIB_OBJ_ID);
 
-        /* Tx object 3. Nothing to do for now. */
+        CaptureEvent(CAPTURE_EVENT_ALARM_FRAME);
 
         // Since the message was sent, clear any error flags.
         g_bErrFlag = 0;
@@ -169,9 +221,9 @@ void can_isr(void)
         // message object 4, and the message TX is complete.
         // Clear the message object interrupt.
 
-        CANIntClear(CAN0_BASE, MESSAGE_PARAM_IIB_OBJ_ID);
+        can_hal_int_clear(MESSAGE_PARAM_IIB_OBJ_ID);
 
-        /* Tx object 4. Nothing to do for now. */
+        CanHealthTxDone(MESSAGE_PARAM_IIB_OBJ_ID);
 
         // Since the message was sent, clear any error flags.
         g_bErrFlag = 0;
@@ -187,9 +239,9 @@ void can_isr(void)
         // message object 5, and the message RX is complete.
         // Clear the message object interrupt.
 
-        CANIntClear(CAN0_BASE, MESSAGE_RESET_UDC_OBJ_ID);
+        can_hal_int_clear(MESSAGE_RESET_UDC_OBJ_ID);
 
-        handle_reset_message();
+        can_rx_push(MESSAGE_RESET_UDC_OBJ_ID, &rx_message_reset_udc);
 
         // Since the message was sent, clear any error flags.
         g_bErrFlag = 0;
@@ -205,9 +257,9 @@ void can_isr(void)
         // message object 6, and the message RX is complete.
         // Clear the message object interrupt.
 
-        CANIntClear(CAN0_BASE, MESSAGE_PARAM_UDC_OBJ_ID);
+        can_hal_int_clear(MESSAGE_PARAM_UDC_OBJ_ID);
 
-        /* Rx object 6. Nothing to do for now. */
+        can_rx_push(MESSAGE_PARAM_UDC_OBJ_ID, &rx_message_param_udc);
 
         // Since the message was sent, clear any error flags.
         g_bErrFlag = 0;
@@ -215,60 +267,76 @@ void can_isr(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Otherwise, something unexpected caused the interrupt.
-    // This should never happen.
-    else
+    // Check if the cause is message object 7, which what we are using for
+    // sending messages.
+    else if(ui32Status == MESSAGE_CAPTURE_IIB_OBJ_ID)
     {
+        // Getting to this point means that the TX interrupt occurred on
+        // message object 7, and the message TX is complete.
+        // Clear the message object interrupt.
 
-        // Spurious interrupt handling can go here.
+        can_hal_int_clear(MESSAGE_CAPTURE_IIB_OBJ_ID);
+
+        CanHealthTxDone(MESSAGE_CAPTURE_IIB_OBJ_ID);
 
+        // Since the message was sent, clear any error flags.
+        g_bErrFlag = 0;
     }
-}
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-void InitCan(uint32_t ui32SysClock)
-{
-    // Configure the GPIO pin muxing to select CAN0 functions for these pins.
-    GPIOPinConfigure(GPIO_PA0_CAN0RX);
-    GPIOPinConfigure(GPIO_PA1_CAN0TX);
+    // Check if the cause is message object 8, which what we are using for
+    // receiving messages.
+    else if(ui32Status == MESSAGE_CAPTURE_UDC_OBJ_ID)
+    {
+        // Getting to this point means that the RX interrupt occurred on
+        // message object 8, and the message RX is complete.
+        // Clear the message object interrupt.
 
-    // Enable the alternate function on the GPIO pins.  The above step selects
-    GPIOPinTypeCAN(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+        can_hal_int_clear(MESSAGE_CAPTURE_UDC_OBJ_ID);
 
-    // Disable CAN0 peripheral
-    SysCtlPeripheralDisable(SYSCTL_PERIPH_CAN0);
+        can_rx_push(MESSAGE_CAPTURE_UDC_OBJ_ID, &rx_message_capture_udc);
 
-    // Reset CAN0 peripheral
-    SysCtlPeripheralReset(SYSCTL_PERIPH_CAN0);
+        // Since the message was sent, clear any error flags.
+        g_bErrFlag = 0;
+    }
 
-    // Enable CAN0 peripheral
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_CAN0);
+/////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Wait for the CAN0 module to be ready.
-    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_CAN0));
+    // Check if the cause is message object 9, which what we are using for
+    // sending messages.
+    else if(ui32Status == MESSAGE_DIAG_IIB_OBJ_ID)
+    {
+        // Getting to this point means that the TX interrupt occurred on
+        // message object 9, and the message TX is complete.
+        // Clear the message object interrupt.
 
-    // Disable the CAN0 module.
-    CANDisable(CAN0_BASE);
+        can_hal_int_clear(MESSAGE_DIAG_IIB_OBJ_ID);
 
-    // Initialize the CAN controller
-    CANInit(CAN0_BASE);
+        CanHealthTxDone(MESSAGE_DIAG_IIB_OBJ_ID);
 
-    // Set up the bit rate for the CAN bus 1Mbps
-    CANBitRateSet(CAN0_BASE, ui32SysClock, 1000000);
+        // Since the message was sent, clear any error flags.
+        g_bErrFlag = 0;
+    }
 
-    // Enable interrupts on the CAN peripheral.
-    CANIntEnable(CAN0_BASE, CAN_INT_MASTER | CAN_INT_ERROR | CAN_INT_STATUS);
+/////////////////////////////////////////////////////////////////////////////////////////////
 
-    CANIntRegister(CAN0_BASE, &can_isr);
+    // Otherwise, something unexpected caused the interrupt.
+    // This should never happen.
+    else
+    {
 
-    IntPrioritySet(INT_CAN0, 1);
+        // Spurious interrupt handling can go here.
+
+    }
+}
 
-    // Disable auto-retry if no ACK-bit is received by the CAN controller.
-    CANRetrySet(CAN0_BASE, 0);
+/////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Enable the CAN for operation.
-    CANEnable(CAN0_BASE);
+void InitCan(uint32_t ui32SysClock)
+{
+    // Pinos, clock, bit rate de 1 Mbps e interrupcao do CAN0
+    can_hal_init(ui32SysClock, &can_isr);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
     /*configuration sending messages*/
@@ -304,6 +372,22 @@ void InitCan(uint32_t ui32SysClock)
     tx_message_param_iib.ui32Flags          = (MSG_OBJ_TX_INT_ENABLE | MSG_OBJ_FIFO);
     tx_message_param_iib.ui32MsgLen         = MESSAGE_PARAM_IIB_LEN;
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //message object 7
+    tx_message_capture_iib.ui32MsgID        = MESSAGE_CAPTURE_IIB_ID;
+    tx_message_capture_iib.ui32MsgIDMask    = 0;
+    tx_message_capture_iib.ui32Flags        = (MSG_OBJ_TX_INT_ENABLE | MSG_OBJ_FIFO);
+    tx_message_capture_iib.ui32MsgLen       = MESSAGE_CAPTURE_IIB_LEN;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //message object 9
+    tx_message_diag_iib.ui32MsgID           = MESSAGE_DIAG_IIB_ID;
+    tx_message_diag_iib.ui32MsgIDMask       = 0;
+    tx_message_diag_iib.ui32Flags           = (MSG_OBJ_TX_INT_ENABLE | MSG_OBJ_FIFO);
+    tx_message_diag_iib.ui32MsgLen          = MESSAGE_DIAG_IIB_LEN;
+
 /////////////////////////////////////////////////////////////////////////////////////////////
     /*configuration receiving messages*/
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -314,7 +398,7 @@ void InitCan(uint32_t ui32SysClock)
     rx_message_reset_udc.ui32Flags          = (MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER | MSG_OBJ_FIFO);
     rx_message_reset_udc.ui32MsgLen         = MESSAGE_RESET_UDC_LEN;
 
-    CANMessageSet(CAN0_BASE, MESSAGE_RESET_UDC_OBJ_ID, &rx_message_reset_udc, MSG_OBJ_TYPE_RX);
+    can_hal_rx_setup(MESSAGE_RESET_UDC_OBJ_ID, &rx_message_reset_udc);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -324,7 +408,17 @@ void InitCan(uint32_t ui32SysClock)
     rx_message_param_udc.ui32Flags         = (MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER | MSG_OBJ_FIFO);
     rx_message_param_udc.ui32MsgLen        = MESSAGE_PARAM_UDC_LEN;
 
-    CANMessageSet(CAN0_BASE, MESSAGE_PARAM_UDC_OBJ_ID, &rx_message_param_udc, MSG_OBJ_TYPE_RX);
+    can_hal_rx_setup(MESSAGE_PARAM_UDC_OBJ_ID, &rx_message_param_udc);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //message object 8
+    rx_message_capture_udc.ui32MsgID       = MESSAGE_CAPTURE_UDC_ID;
+    rx_message_capture_udc.ui32MsgIDMask   = 0xfffff;
+    rx_message_capture_udc.ui32Flags       = (MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER | MSG_OBJ_FIFO);
+    rx_message_capture_udc.ui32MsgLen      = MESSAGE_CAPTURE_UDC_LEN;
+
+    can_hal_rx_setup(MESSAGE_CAPTURE_UDC_OBJ_ID, &rx_message_capture_udc);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -337,28 +431,102 @@ void InitCan(uint32_t ui32SysClock)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-void handle_reset_message(void)
+// Unico ponto de envio: todo quadro de TX passa por aqui, inclusive as novas
+// tentativas de can_resend(), e toda recepcao entra por can_rx_push()
+static void can_transmit(uint8_t obj_id, tCANMsgObject *msg, uint8_t *data)
 {
-    uint8_t id;
+    msg->pui8MsgData = data;
+
+    CanHealthTxStart(obj_id, data);
+
+    can_hal_tx(obj_id, msg);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_rx_dispatch(void)
+{
+    can_rx_frame_t *frame;
+    bool done;
+
+    while(rx_tail != rx_head)
+    {
+        frame = &rx_queue[rx_tail];
+
+        done = 1;
+
+        switch(frame->obj_id)
+        {
+        case MESSAGE_RESET_UDC_OBJ_ID:
+            done = handle_reset_message(frame->data);
+            break;
+
+        case MESSAGE_PARAM_UDC_OBJ_ID:
+            done = handle_param_message(frame->data);
+            break;
 
-    rx_message_reset_udc.pui8MsgData = message_reset_udc;
+        case MESSAGE_CAPTURE_UDC_OBJ_ID:
+            done = handle_capture_message(frame->data);
+            break;
 
-    CANMessageGet(CAN0_BASE, MESSAGE_RESET_UDC_OBJ_ID, &rx_message_reset_udc, 0);
+        default:
+            break;
+        }
 
-    id = message_reset_udc[0];
+        // Destino ainda ocupado com o comando anterior: tenta no proximo ciclo
+        if(!done) return;
 
-    if (id == 1)
+        rx_tail = (rx_tail + 1) & (CAN_RX_QUEUE_SIZE - 1);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t get_can_rx_overflow(void)
+{
+    return rx_overflow;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool handle_reset_message(const uint8_t *data)
+{
+    if (data[0] == 1)
     {
         InterlockClear();
 
-        send_itlk_message(1);
+        FirstFaultItlkSend(1);
 
         AlarmClear();
 
-        send_alarm_message(1);
-
-        message_reset_udc[0] = 0;
+        FirstFaultAlarmSend(1);
     }
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool handle_param_message(const uint8_t *data)
+{
+    // Somente o modulo enderecado responde
+    if (data[0] != can_address) return 1;
+
+    return ParamRequest(data[1], data[2],
+                        data[4] | ((uint32_t)data[5] << 8) |
+                        ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool handle_capture_message(const uint8_t *data)
+{
+    // Somente o modulo enderecado responde
+    if (data[0] != can_address) return 1;
+
+    return CaptureRequest(data[1], data[2] | ((uint16_t)data[3] << 8),
+                          data[4] | ((uint32_t)data[5] << 8) |
+                          ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24));
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -374,9 +542,7 @@ void send_data_message(uint8_t var)
     message_data_iib[6] = g_controller_iib.iib_signals[var].u8[2];
     message_data_iib[7] = g_controller_iib.iib_signals[var].u8[3];
 
-    tx_message_data_iib.pui8MsgData = message_data_iib;
-
-    CANMessageSet(CAN0_BASE, MESSAGE_DATA_IIB_OBJ_ID, &tx_message_data_iib, MSG_OBJ_TYPE_TX);
+    can_transmit(MESSAGE_DATA_IIB_OBJ_ID, &tx_message_data_iib, message_data_iib);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -392,9 +558,7 @@ void send_itlk_message(uint8_t var)
     message_itlk_iib[6] = g_controller_iib.iib_itlk[var].u8[2];
     message_itlk_iib[7] = g_controller_iib.iib_itlk[var].u8[3];
 
-    tx_message_itlk_iib.pui8MsgData = message_itlk_iib;
-
-    CANMessageSet(CAN0_BASE, MESSAGE_ITLK_IIB_OBJ_ID, &tx_message_itlk_iib, MSG_OBJ_TYPE_TX);
+    can_transmit(MESSAGE_ITLK_IIB_OBJ_ID, &tx_message_itlk_iib, message_itlk_iib);
 
     message_itlk_iib[0] = 0;
     message_itlk_iib[1] = 0;
@@ -413,9 +577,7 @@ void send_alarm_message(uint8_t var)
     message_alarm_iib[6] = g_controller_iib.iib_alarm[var].u8[2];
     message_alarm_iib[7] = g_controller_iib.iib_alarm[var].u8[3];
 
-    tx_message_alarm_iib.pui8MsgData = message_alarm_iib;
-
-    CANMessageSet(CAN0_BASE, MESSAGE_ALARM_IIB_OBJ_ID, &tx_message_alarm_iib, MSG_OBJ_TYPE_TX);
+    can_transmit(MESSAGE_ALARM_IIB_OBJ_ID, &tx_message_alarm_iib, message_alarm_iib);
 
     message_alarm_iib[0] = 0;
     message_alarm_iib[1] = 0;
@@ -423,6 +585,68 @@ void send_alarm_message(uint8_t var)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+void send_param_message(uint8_t cmd, uint8_t index, uint8_t status, uint32_t value)
+{
+    message_param_iib[0] = can_address;
+    message_param_iib[1] = cmd;
+    message_param_iib[2] = index;
+    message_param_iib[3] = status;
+    message_param_iib[4] = (uint8_t)value;
+    message_param_iib[5] = (uint8_t)(value >> 8);
+    message_param_iib[6] = (uint8_t)(value >> 16);
+    message_param_iib[7] = (uint8_t)(value >> 24);
+
+    can_transmit(MESSAGE_PARAM_IIB_OBJ_ID, &tx_message_param_iib, message_param_iib);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void send_capture_message(uint8_t cmd, uint16_t index, uint32_t value)
+{
+    message_capture_iib[0] = can_address;
+    message_capture_iib[1] = cmd;
+    message_capture_iib[2] = (uint8_t)index;
+    message_capture_iib[3] = (uint8_t)(index >> 8);
+    message_capture_iib[4] = (uint8_t)value;
+    message_capture_iib[5] = (uint8_t)(value >> 8);
+    message_capture_iib[6] = (uint8_t)(value >> 16);
+    message_capture_iib[7] = (uint8_t)(value >> 24);
+
+    can_transmit(MESSAGE_CAPTURE_IIB_OBJ_ID, &tx_message_capture_iib, message_capture_iib);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void send_diag_message(uint8_t item, uint16_t aux, uint32_t value)
+{
+    message_diag_iib[0] = can_address;
+    message_diag_iib[1] = item;
+    message_diag_iib[2] = (uint8_t)aux;
+    message_diag_iib[3] = (uint8_t)(aux >> 8);
+    message_diag_iib[4] = (uint8_t)value;
+    message_diag_iib[5] = (uint8_t)(value >> 8);
+    message_diag_iib[6] = (uint8_t)(value >> 16);
+    message_diag_iib[7] = (uint8_t)(value >> 24);
+
+    can_transmit(MESSAGE_DIAG_IIB_OBJ_ID, &tx_message_diag_iib, message_diag_iib);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_resend(uint8_t obj_id, uint8_t *data)
+{
+    tCANMsgObject *msg;
+
+    // Somente interlock e alarme sao retransmitidos
+    if(obj_id == MESSAGE_ITLK_IIB_OBJ_ID) msg = &tx_message_itlk_iib;
+    else if(obj_id == MESSAGE_ALARM_IIB_OBJ_ID) msg = &tx_message_alarm_iib;
+    else return;
+
+    can_transmit(obj_id, msg, data);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 uint16_t get_can_address(void)
 {
     return can_address;
@@ -6,6 +6,7 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #define MESSAGE_DATA_IIB_LEN          8
@@ -30,24 +31,62 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+#define MESSAGE_CAPTURE_IIB_LEN       8
+#define MESSAGE_CAPTURE_IIB_OBJ_ID    7
+
+#define MESSAGE_CAPTURE_UDC_LEN       8
+#define MESSAGE_CAPTURE_UDC_OBJ_ID    8
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define MESSAGE_DIAG_IIB_LEN          8
+#define MESSAGE_DIAG_IIB_OBJ_ID       9
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quadros recebidos aguardando o loop principal (potencia de 2)
+#define CAN_RX_QUEUE_SIZE             16
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    uint8_t obj_id;
+    uint8_t data[8];
+} can_rx_frame_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 typedef enum {
     MESSAGE_DATA_IIB_ID = 1,
     MESSAGE_ITLK_IIB_ID,
     MESSAGE_ALARM_IIB_ID,
     MESSAGE_PARAM_IIB_ID,
     MESSAGE_RESET_UDC_ID,
-    MESSAGE_PARAM_UDC_ID
+    MESSAGE_PARAM_UDC_ID,
+    MESSAGE_CAPTURE_IIB_ID,
+    MESSAGE_CAPTURE_UDC_ID,
+    MESSAGE_DIAG_IIB_ID
 }can_message_id_t;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 extern void can_isr(void);
 extern void InitCan(uint32_t ui32SysClock);
-extern void handle_reset_message(void);
+extern void can_rx_dispatch(void);
+extern uint32_t get_can_rx_overflow(void);
+extern bool handle_reset_message(const uint8_t *data);
 extern void send_data_message(uint8_t var);
 extern uint16_t get_can_address(void);
 extern void send_itlk_message(uint8_t var);
 extern void send_alarm_message(uint8_t var);
+extern bool handle_param_message(const uint8_t *data);
+extern void send_param_message(uint8_t cmd, uint8_t index, uint8_t status, uint32_t value);
+extern bool handle_capture_message(const uint8_t *data);
+extern void send_capture_message(uint8_t cmd, uint16_t index, uint32_t value);
+extern void send_diag_message(uint8_t item, uint16_t aux, uint32_t value);
+extern void can_resend(uint8_t obj_id, uint8_t *data);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
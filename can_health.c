@@ -0,0 +1,288 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file can_health.c
+ * @brief CAN bus health monitoring and bus-off recovery.
+ *
+ * CanHealthStatus() and CanHealthTxDone() run in can_isr(); everything else
+ * runs in the main loop. With auto-retry disabled the controller clears the
+ * TX request of a frame that lost arbitration or hit an error without raising
+ * the TX interrupt, so a request that disappeared without CanHealthTxDone()
+ * is counted as lost.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/can.h"
+#include "can_health.h"
+#include "can_bus.h"
+#include "peripheral_drivers/timer/timer.h"
+#include "peripheral_drivers/can/can_hal.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile can_state_t can_state = CAN_STATE_ACTIVE;
+
+static volatile uint32_t tec = 0;
+static volatile uint32_t rec = 0;
+
+static volatile uint32_t bus_off_count = 0;
+static volatile uint32_t passive_count = 0;
+static volatile uint32_t error_count = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile bool bus_off_pending = 0;
+static volatile uint16_t backoff_ms = CAN_BUSOFF_BACKOFF_MIN_MS;
+static uint32_t recovery_ms = 0;
+static bool recovery_wait = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile bool     tx_pending[CAN_HEALTH_MAX_OBJ];
+static volatile uint32_t tx_stamp[CAN_HEALTH_MAX_OBJ];
+static uint8_t           tx_retries[CAN_HEALTH_MAX_OBJ];
+static uint8_t           tx_copy[CAN_HEALTH_MAX_OBJ][8];
+
+static volatile uint32_t tx_lost = 0;
+static volatile uint32_t tx_retry_count = 0;
+static volatile uint32_t tx_latency_max = 0;
+static volatile uint32_t tx_latency_last = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t publish_ms = 0;
+static uint8_t  publish_next = CAN_HEALTH_NUM_ITEMS;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool can_health_critical(uint8_t obj_id)
+{
+    return (obj_id == MESSAGE_ITLK_IIB_OBJ_ID || obj_id == MESSAGE_ALARM_IIB_OBJ_ID);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CanHealthStatus(uint32_t status)
+{
+    uint32_t lec = status & CAN_STATUS_LEC_MSK;
+    uint32_t rx_count;
+    uint32_t tx_count;
+    can_state_t state;
+
+    // LEC_MSK significa "sem alteracao desde a ultima leitura"
+    if(lec != CAN_STATUS_LEC_NONE && lec != CAN_STATUS_LEC_MSK) error_count++;
+
+    can_hal_error_counters(&rx_count, &tx_count);
+
+    rec = rx_count;
+    tec = tx_count;
+
+    if(status & CAN_STATUS_BUS_OFF) state = CAN_STATE_BUS_OFF;
+    else if(status & CAN_STATUS_EPASS) state = CAN_STATE_PASSIVE;
+    else if(status & CAN_STATUS_EWARN) state = CAN_STATE_WARNING;
+    else state = CAN_STATE_ACTIVE;
+
+    if(state != can_state)
+    {
+        if(state == CAN_STATE_BUS_OFF)
+        {
+            bus_off_count++;
+            bus_off_pending = 1;
+        }
+        else if(state == CAN_STATE_PASSIVE && can_state != CAN_STATE_BUS_OFF) passive_count++;
+
+        can_state = state;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CanHealthTxStart(uint8_t obj_id, const uint8_t *data)
+{
+    uint8_t i;
+    uint8_t idx = obj_id - 1;
+
+    if(idx >= CAN_HEALTH_MAX_OBJ) return;
+
+    // Chamado antes do CANMessageSet: um quadro anterior ainda na fila sera sobrescrito
+    if(tx_pending[idx] && (can_hal_tx_requests() & (1 << idx))) tx_lost++;
+
+    for(i = 0; i < 8; i++) tx_copy[idx][i] = data[i];
+
+    tx_retries[idx] = 0;
+    tx_stamp[idx] = get_micros();
+    tx_pending[idx] = 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CanHealthTxDone(uint8_t obj_id)
+{
+    uint8_t idx = obj_id - 1;
+    uint32_t latency;
+
+    if(idx >= CAN_HEALTH_MAX_OBJ || !tx_pending[idx]) return;
+
+    latency = get_micros() - tx_stamp[idx];
+
+    tx_latency_last = latency;
+    if(latency > tx_latency_max) tx_latency_max = latency;
+
+    tx_pending[idx] = 0;
+
+    // Quadro transmitido: o barramento voltou, a proxima espera recomeca do minimo
+    backoff_ms = CAN_BUSOFF_BACKOFF_MIN_MS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CanHealthTxBusy(uint8_t obj_id)
+{
+    uint8_t idx = obj_id - 1;
+
+    if(idx >= CAN_HEALTH_MAX_OBJ) return 0;
+
+    return tx_pending[idx];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void can_health_tx_check(void)
+{
+    uint8_t idx;
+    uint8_t retries;
+    uint32_t requests;
+    uint32_t now = get_micros();
+
+    requests = can_hal_tx_requests();
+
+    for(idx = 0; idx < CAN_HEALTH_MAX_OBJ; idx++)
+    {
+        if(!tx_pending[idx]) continue;
+
+        // Ainda aguardando o barramento
+        if(requests & (1 << idx)) continue;
+
+        if((now - tx_stamp[idx]) < CAN_TX_TIMEOUT_US) continue;
+
+        if(can_health_critical(idx + 1) && tx_retries[idx] < CAN_TX_RETRY_MAX &&
+           can_state != CAN_STATE_BUS_OFF)
+        {
+            retries = tx_retries[idx] + 1;
+            tx_retry_count++;
+
+            // can_resend() passa por can_transmit(), que reinicia o registro do objeto
+            can_resend(idx + 1, tx_copy[idx]);
+
+            tx_retries[idx] = retries;
+        }
+        else
+        {
+            tx_lost++;
+            tx_pending[idx] = 0;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void can_health_bus_off(uint32_t now)
+{
+    if(bus_off_pending)
+    {
+        bus_off_pending = 0;
+        recovery_wait = 1;
+        recovery_ms = now + backoff_ms;
+    }
+
+    if(!recovery_wait || (int32_t)(now - recovery_ms) < 0) return;
+
+    recovery_wait = 0;
+
+    // Um novo bus-off antes de um TX bem sucedido dobra a espera
+    if(backoff_ms < CAN_BUSOFF_BACKOFF_MAX_MS / 2) backoff_ms *= 2;
+    else backoff_ms = CAN_BUSOFF_BACKOFF_MAX_MS;
+
+    // Limpa o INIT; o controlador aguarda 128 x 11 bits recessivos antes de voltar
+    can_hal_enable();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t CanHealthRead(can_health_item_t item)
+{
+    switch(item)
+    {
+    case CAN_HEALTH_STATE:
+        return can_state | ((tec & 0xFF) << 8) | ((rec & 0xFF) << 16);
+
+    case CAN_HEALTH_BUS_OFF:
+        return bus_off_count;
+
+    case CAN_HEALTH_PASSIVE:
+        return passive_count;
+
+    case CAN_HEALTH_ERRORS:
+        return error_count;
+
+    case CAN_HEALTH_TX_LOST:
+        return tx_lost;
+
+    case CAN_HEALTH_TX_RETRY:
+        return tx_retry_count;
+
+    case CAN_HEALTH_TX_LATENCY_MAX:
+        return tx_latency_max;
+
+    case CAN_HEALTH_TX_LATENCY_LAST:
+        return tx_latency_last;
+
+    case CAN_HEALTH_RX_OVERFLOW:
+        return get_can_rx_overflow();
+
+    default:
+        return 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CanHealthService(void)
+{
+    uint32_t now = get_millis();
+
+    can_health_bus_off(now);
+
+    if(can_state == CAN_STATE_BUS_OFF) return;
+
+    can_health_tx_check();
+
+    if((now - publish_ms) >= CAN_HEALTH_PERIOD_MS)
+    {
+        publish_ms = now;
+        publish_next = 0;
+    }
+
+    // Um item por chamada, para nao sobrescrever o objeto de TX
+    if(publish_next < CAN_HEALTH_NUM_ITEMS)
+    {
+        send_diag_message(publish_next, 0, CanHealthRead((can_health_item_t)publish_next));
+        publish_next++;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file can_health.h
+ * @brief CAN bus health monitoring and bus-off recovery.
+ *
+ * Tracks the controller error counters and state, the frames lost on each TX
+ * message object (arbitration or error with auto-retry disabled, or overwritten
+ * while still queued) and the TX latency. Interlock and alarm frames are
+ * retried a few times; bus-off is recovered with an exponential backoff.
+ *
+ * Counters are published every CAN_HEALTH_PERIOD_MS on MESSAGE_DIAG_IIB:
+ * [0] can_address, [1] item (can_health_item_t), [2..3] 0, [4..7] value (u32)
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAN_HEALTH_H_
+#define CAN_HEALTH_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Objetos de TX acompanhados (IDs 1 a CAN_HEALTH_MAX_OBJ)
+#define CAN_HEALTH_MAX_OBJ                      9
+
+// Sem confirmacao apos este tempo o quadro e considerado perdido
+#define CAN_TX_TIMEOUT_US                       2000
+
+// Tentativas extras para os quadros de interlock e alarme
+#define CAN_TX_RETRY_MAX                        3
+
+// Espera antes de religar o controlador apos bus-off
+#define CAN_BUSOFF_BACKOFF_MIN_MS               10
+#define CAN_BUSOFF_BACKOFF_MAX_MS               1000
+
+// Periodo de publicacao dos contadores
+#define CAN_HEALTH_PERIOD_MS                    1000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    CAN_STATE_ACTIVE = 0,
+    CAN_STATE_WARNING,
+    CAN_STATE_PASSIVE,
+    CAN_STATE_BUS_OFF
+}can_state_t;
+
+typedef enum {
+    CAN_HEALTH_STATE = 0,       // estado | TEC << 8 | REC << 16
+    CAN_HEALTH_BUS_OFF,         // entradas em bus-off
+    CAN_HEALTH_PASSIVE,         // entradas em error-passive
+    CAN_HEALTH_ERRORS,          // interrupcoes com codigo de erro (LEC)
+    CAN_HEALTH_TX_LOST,         // quadros perdidos sem nova tentativa
+    CAN_HEALTH_TX_RETRY,        // novas tentativas de interlock/alarme
+    CAN_HEALTH_TX_LATENCY_MAX,  // maior latencia de TX, us
+    CAN_HEALTH_TX_LATENCY_LAST, // ultima latencia de TX, us
+    CAN_HEALTH_RX_OVERFLOW,     // quadros descartados com a fila de RX cheia
+    CAN_HEALTH_NUM_ITEMS
+}can_health_item_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void CanHealthStatus(uint32_t status);
+extern void CanHealthTxStart(uint8_t obj_id, const uint8_t *data);
+extern void CanHealthTxDone(uint8_t obj_id);
+extern bool CanHealthTxBusy(uint8_t obj_id);
+extern void CanHealthService(void);
+extern uint32_t CanHealthRead(can_health_item_t item);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* CAN_HEALTH_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
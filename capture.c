@@ -0,0 +1,491 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file capture.c
+ * @brief Post-mortem waveform capture of the internal ADC channels.
+ *
+ * CaptureSample() runs in the 1ms timer interrupt right after sample_adc().
+ * Trigger, re-arm and the CAN transfer run in the main loop; the interrupt
+ * only sees the trigger request flag and the state variable.
+ *
+ * With AdcInjectEnable the same buffer can be replayed: CaptureReplay()
+ * overwrites the captured channels of each new reading, while the state
+ * CAPTURE_REPLAY keeps CaptureSample() from recording over the trace.
+ * Events are stamped with the replay sample number, not with time. The
+ * replay starts with the 1s task cycle and the 100us channel rotation both at
+ * slot 0, so the ALARM, INTERLOCK and RELAY_OFF events of two replays of one
+ * trace on one build land on the same samples. The *_FRAME events wait for
+ * the CAN bus and move with the traffic on it.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/interrupt.h"
+#include "capture.h"
+#include "can_bus.h"
+#include "can_health.h"
+#include "adc_internal.h"
+#include "fault_log.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CAPTURE_MAX_CHANNELS        14
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint16_t capture_buffer[CAPTURE_BUFFER_WORDS];
+
+static uint8_t  channel_list[CAPTURE_MAX_CHANNELS];
+static uint8_t  channel_count = 0;
+static uint16_t channel_mask = 0;
+
+static uint16_t pre_samples = 0;
+static uint16_t post_samples = 0;
+static uint16_t depth = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile capture_state_t capture_state = CAPTURE_IDLE;
+static volatile bool trigger_request = 0;
+
+static volatile uint16_t write_index = 0;
+static volatile uint16_t valid_samples = 0;
+static volatile uint16_t post_remaining = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Comando recebido pelo CAN, executado no loop principal
+static volatile bool    request_pending = 0;
+static volatile uint8_t request_cmd = 0;
+static volatile uint16_t request_index = 0;
+static volatile uint32_t request_value = 0;
+
+static uint32_t segment_next = 0;
+static uint32_t segment_end = 0;
+
+// Cursor de leitura do log persistente, em palavras
+static uint32_t log_next = 0;
+static uint32_t log_end = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#if (AdcInjectEnable == 1)
+
+typedef struct
+{
+    uint16_t sample;
+    uint8_t  event;
+} capture_event_entry_t;
+
+static capture_event_entry_t event_log[CAPTURE_MAX_EVENTS];
+static volatile uint8_t event_count = 0;
+
+static volatile bool     replay_request = 0;
+static volatile uint16_t replay_sample = 0;
+
+static uint32_t event_next = 0;
+static uint32_t event_end = 0;
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Posicao no buffer da palavra "word", contada a partir da amostra mais antiga
+static uint16_t *capture_word_ptr(uint32_t word)
+{
+    uint16_t sample;
+    uint16_t oldest;
+
+    if(word >= (uint32_t)valid_samples * channel_count) return 0;
+
+    sample = word / channel_count;
+
+    oldest = (write_index + depth - valid_samples) % depth;
+
+    return &capture_buffer[((oldest + sample) % depth) * channel_count + (word % channel_count)];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint16_t capture_word(uint32_t word)
+{
+    uint16_t *ptr = capture_word_ptr(word);
+
+    return ptr ? *ptr : 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void capture_send_status(void)
+{
+    uint16_t trigger_position = 0;
+
+    if(capture_state == CAPTURE_FROZEN && valid_samples > post_samples) trigger_position = valid_samples - post_samples;
+
+    send_capture_message(CAPTURE_CMD_STATUS, capture_state | ((uint16_t)channel_count << 8),
+                         valid_samples | ((uint32_t)trigger_position << 16));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CaptureInit(uint16_t mask, uint16_t pre_trigger, uint16_t post_trigger)
+{
+    uint8_t i;
+    uint16_t max_depth;
+
+    capture_state = CAPTURE_IDLE;
+
+    channel_count = 0;
+
+    for(i = 0; i < CAPTURE_MAX_CHANNELS; i++)
+    {
+        if(mask & (1 << i)) channel_list[channel_count++] = i;
+    }
+
+    channel_mask = mask;
+
+    if(channel_count == 0) return;
+
+    max_depth = CAPTURE_BUFFER_WORDS / channel_count;
+
+    if(post_trigger == 0) post_trigger = 1;
+    if(post_trigger > max_depth) post_trigger = max_depth;
+    if(pre_trigger > max_depth - post_trigger) pre_trigger = max_depth - post_trigger;
+
+    pre_samples = pre_trigger;
+    post_samples = post_trigger;
+    depth = pre_trigger + post_trigger;
+
+    CaptureArm();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CaptureArm(void)
+{
+    if(channel_count == 0) return;
+
+    // O estado IDLE faz a interrupcao ignorar o buffer enquanto os indices sao zerados
+    capture_state = CAPTURE_IDLE;
+
+    trigger_request = 0;
+    write_index = 0;
+    valid_samples = 0;
+    post_remaining = 0;
+
+    capture_state = CAPTURE_ARMED;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CaptureTrigger(void)
+{
+    if(capture_state == CAPTURE_ARMED) trigger_request = 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+capture_state_t CaptureStateRead(void)
+{
+    return capture_state;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CaptureSample(const uint32_t *adc0, const uint32_t *adc1)
+{
+    uint8_t i;
+    uint8_t ch;
+    uint16_t *dst;
+
+    if(capture_state != CAPTURE_ARMED && capture_state != CAPTURE_TRIGGERED) return;
+
+    dst = &capture_buffer[write_index * channel_count];
+
+    for(i = 0; i < channel_count; i++)
+    {
+        ch = channel_list[i];
+
+        if(ch < 7) dst[i] = (uint16_t)adc0[ch];
+        else dst[i] = (uint16_t)adc1[ch - 7];
+    }
+
+    write_index++;
+    if(write_index >= depth) write_index = 0;
+
+    if(valid_samples < depth) valid_samples++;
+
+    if(capture_state == CAPTURE_ARMED)
+    {
+        if(trigger_request)
+        {
+            trigger_request = 0;
+            post_remaining = post_samples;
+            capture_state = CAPTURE_TRIGGERED;
+        }
+    }
+    else
+    {
+        post_remaining--;
+        if(post_remaining == 0) capture_state = CAPTURE_FROZEN;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CaptureReplay(uint32_t *adc0, uint32_t *adc1)
+{
+#if (AdcInjectEnable == 1)
+
+    uint8_t i;
+    uint8_t ch;
+    uint16_t *src;
+
+    if(capture_state != CAPTURE_REPLAY) return;
+
+    if(replay_sample >= valid_samples)
+    {
+        CaptureEvent(CAPTURE_EVENT_END);
+        capture_state = CAPTURE_FROZEN;
+        return;
+    }
+
+    src = capture_word_ptr((uint32_t)replay_sample * channel_count);
+
+    // Canais fora da mascara da captura seguem com a leitura real
+    for(i = 0; i < channel_count; i++)
+    {
+        ch = channel_list[i];
+
+        if(ch < 7) adc0[ch] = src[i];
+        else adc1[ch - 7] = src[i];
+    }
+
+    replay_sample++;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char CaptureReplaySync(void)
+{
+#if (AdcInjectEnable == 1)
+
+    if(!replay_request) return 0;
+
+    replay_request = 0;
+
+    if(capture_state != CAPTURE_FROZEN) return 0;
+
+    replay_sample = 0;
+    event_count = 0;
+
+    capture_state = CAPTURE_REPLAY;
+
+    CaptureEvent(CAPTURE_EVENT_START);
+
+    return 1;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CaptureEvent(capture_event_t event)
+{
+#if (AdcInjectEnable == 1)
+
+    if(capture_state != CAPTURE_REPLAY) return;
+
+    // Chamado do loop principal e das interrupcoes de 1ms e do CAN
+    IntMasterDisable();
+
+    if(event_count < CAPTURE_MAX_EVENTS)
+    {
+        event_log[event_count].sample = replay_sample;
+        event_log[event_count].event = event;
+        event_count++;
+    }
+
+    IntMasterEnable();
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CaptureRequest(uint8_t cmd, uint16_t index, uint32_t value)
+{
+    if(request_pending) return 0;
+
+    request_cmd = cmd;
+    request_index = index;
+    request_value = value;
+    request_pending = 1;
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CaptureTransfer(void)
+{
+    uint32_t word;
+
+    // Quadro anterior ainda no objeto de TX: resposta e segmento esperam a proxima chamada
+    if(CanHealthTxBusy(MESSAGE_CAPTURE_IIB_OBJ_ID)) return;
+
+    if(request_pending)
+    {
+        request_pending = 0;
+
+        switch(request_cmd)
+        {
+        case CAPTURE_CMD_STATUS:
+            capture_send_status();
+            break;
+
+        case CAPTURE_CMD_CONFIG:
+            send_capture_message(CAPTURE_CMD_CONFIG, channel_mask,
+                                 pre_samples | ((uint32_t)post_samples << 16));
+            break;
+
+        case CAPTURE_CMD_READ:
+            // Somente um buffer congelado pode ser lido
+            if(capture_state == CAPTURE_FROZEN)
+            {
+                segment_next = request_index;
+                segment_end = segment_next + request_value;
+            }
+            else capture_send_status();
+            break;
+
+        case CAPTURE_CMD_ARM:
+            segment_end = 0;
+            segment_next = 0;
+#if (AdcInjectEnable == 1)
+            replay_request = 0;
+#endif
+            CaptureArm();
+            capture_send_status();
+            break;
+
+        case CAPTURE_CMD_TRIGGER:
+            CaptureTrigger();
+            capture_send_status();
+            break;
+
+#if (AdcInjectEnable == 1)
+
+        case CAPTURE_CMD_LOAD:
+            if(channel_count && capture_state != CAPTURE_REPLAY)
+            {
+                capture_state = CAPTURE_IDLE;
+
+                segment_end = 0;
+                segment_next = 0;
+
+                valid_samples = (request_index < depth) ? request_index : depth;
+                write_index = valid_samples % depth;
+
+                capture_state = CAPTURE_FROZEN;
+            }
+            capture_send_status();
+            break;
+
+        case CAPTURE_CMD_WRITE:
+            if(capture_state == CAPTURE_FROZEN && capture_word_ptr(request_index * 2 + 1))
+            {
+                *capture_word_ptr(request_index * 2) = request_value & 0xFFFF;
+                *capture_word_ptr(request_index * 2 + 1) = request_value >> 16;
+
+                send_capture_message(CAPTURE_CMD_WRITE, request_index, request_value);
+            }
+            else capture_send_status();
+            break;
+
+        case CAPTURE_CMD_REPLAY:
+            if(capture_state == CAPTURE_FROZEN) replay_request = 1;
+            capture_send_status();
+            break;
+
+        case CAPTURE_CMD_EVENTS:
+            event_next = request_index;
+            event_end = request_index + request_value;
+            if(event_end > event_count) event_end = event_count;
+            break;
+
+#endif
+
+        case CAPTURE_CMD_LOG_STATUS:
+            send_capture_message(CAPTURE_CMD_LOG_STATUS, FaultLogCount(), FaultLogNextSeq());
+            break;
+
+        case CAPTURE_CMD_LOG_READ:
+            log_next = (uint32_t)request_index * FAULT_LOG_RECORD_WORDS;
+            log_end = log_next + request_value * FAULT_LOG_RECORD_WORDS;
+            if(log_end > (uint32_t)FaultLogCount() * FAULT_LOG_RECORD_WORDS)
+                log_end = (uint32_t)FaultLogCount() * FAULT_LOG_RECORD_WORDS;
+            break;
+
+        default:
+            break;
+        }
+
+        return;
+    }
+
+    // Um segmento por chamada
+    if(segment_next < segment_end)
+    {
+        word = segment_next * 2;
+
+        send_capture_message(CAPTURE_CMD_READ, segment_next,
+                             capture_word(word) | ((uint32_t)capture_word(word + 1) << 16));
+
+        segment_next++;
+    }
+
+#if (AdcInjectEnable == 1)
+
+    else if(event_next < event_end)
+    {
+        send_capture_message(CAPTURE_CMD_EVENTS, event_next,
+                             event_log[event_next].sample | ((uint32_t)event_log[event_next].event << 16));
+
+        event_next++;
+    }
+
+#endif
+
+    else if(log_next < log_end)
+    {
+        // EEPROM gravando: a mesma palavra e tentada na proxima chamada
+        if(FaultLogRead(log_next / FAULT_LOG_RECORD_WORDS, log_next % FAULT_LOG_RECORD_WORDS, &word))
+        {
+            send_capture_message(CAPTURE_CMD_LOG_READ, log_next, word);
+
+            log_next++;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file capture.h
+ * @brief Post-mortem waveform capture of the internal ADC channels.
+ *
+ * The raw codes read by sample_adc() are kept in a circular buffer. The first
+ * interlock freezes a pre-trigger and post-trigger window, which stays frozen
+ * until it is re-armed over CAN.
+ *
+ * Frames on MESSAGE_CAPTURE_UDC / MESSAGE_CAPTURE_IIB:
+ * [0] can_address, [1] command, [2..3] index (u16), [4..7] value (u32)
+ *
+ * CAPTURE_CMD_STATUS  -> index = state | (channels << 8)
+ *                        value = samples | (trigger position << 16)
+ * CAPTURE_CMD_CONFIG  -> index = channel mask
+ *                        value = pre-trigger | (post-trigger << 16)
+ * CAPTURE_CMD_READ    index = first segment, value = segment count.
+ *                     One reply per segment: index = segment,
+ *                     value = two samples, oldest first, channels interleaved.
+ * CAPTURE_CMD_ARM     re-arm, replies status
+ * CAPTURE_CMD_TRIGGER manual trigger, replies status
+ *
+ * Replay (only with AdcInjectEnable), to run a trace recorded on a tripped
+ * rack against another firmware build:
+ * CAPTURE_CMD_LOAD    index = sample count. Discards the buffer and freezes
+ *                     it with that many samples of the configured channels;
+ *                     replies status
+ * CAPTURE_CMD_WRITE   index = segment, value = two samples, same layout as
+ *                     CAPTURE_CMD_READ; echoes the frame
+ * CAPTURE_CMD_REPLAY  plays the frozen buffer, oldest first, one sample per
+ *                     1ms in place of the ADC readings. Starts at the top of
+ *                     the 1s task cycle and of the 100us channel rotation so
+ *                     a replay always lines up with the same periodic tasks;
+ *                     replies status
+ * CAPTURE_CMD_EVENTS  index = first event, value = event count. One reply per
+ *                     event: index = event, value = sample | (event << 16)
+ *
+ * Persistent fault log (fault_log.h), on the same frames:
+ * CAPTURE_CMD_LOG_STATUS -> index = records stored, value = next sequence
+ * CAPTURE_CMD_LOG_READ   index = first record (0 = oldest), value = record
+ *                        count. One reply per word: index = record * 16 +
+ *                        word, value = word
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Tamanho do buffer em amostras de 16 bits (todas as entradas somadas)
+#define CAPTURE_BUFFER_WORDS                    16384
+
+// Eventos guardados por replay
+#define CAPTURE_MAX_EVENTS                      32
+
+// Janela padrao, em amostras de 1ms
+#define CAPTURE_PRE_TRIGGER                     1500
+#define CAPTURE_POST_TRIGGER                    500
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Canais do ADC interno, na ordem de adc_0_value[] e adc_1_value[]
+#define CAPTURE_VOLTAGE_CH1                     0x0001
+#define CAPTURE_VOLTAGE_CH2                     0x0002
+#define CAPTURE_VOLTAGE_CH3                     0x0004
+#define CAPTURE_VOLTAGE_CH4                     0x0008
+#define CAPTURE_LV_CURRENT_CH1                  0x0010
+#define CAPTURE_LV_CURRENT_CH2                  0x0020
+#define CAPTURE_LV_CURRENT_CH3                  0x0040
+#define CAPTURE_CURRENT_CH1                     0x0080
+#define CAPTURE_CURRENT_CH2                     0x0100
+#define CAPTURE_CURRENT_CH3                     0x0200
+#define CAPTURE_CURRENT_CH4                     0x0400
+#define CAPTURE_DRIVER_VOLTAGE                  0x0800
+#define CAPTURE_DRIVER2_CURRENT                 0x1000
+#define CAPTURE_DRIVER1_CURRENT                 0x2000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    CAPTURE_IDLE = 0,
+    CAPTURE_ARMED,
+    CAPTURE_TRIGGERED,
+    CAPTURE_FROZEN,
+    CAPTURE_REPLAY
+}capture_state_t;
+
+typedef enum {
+    CAPTURE_CMD_STATUS = 1,
+    CAPTURE_CMD_CONFIG,
+    CAPTURE_CMD_READ,
+    CAPTURE_CMD_ARM,
+    CAPTURE_CMD_TRIGGER,
+    CAPTURE_CMD_LOAD,
+    CAPTURE_CMD_WRITE,
+    CAPTURE_CMD_REPLAY,
+    CAPTURE_CMD_EVENTS,
+    CAPTURE_CMD_LOG_STATUS,
+    CAPTURE_CMD_LOG_READ
+}capture_cmd_t;
+
+// Eventos registrados durante o replay, com o numero da amostra
+typedef enum {
+    CAPTURE_EVENT_START = 1,
+    CAPTURE_EVENT_ALARM,
+    CAPTURE_EVENT_INTERLOCK,
+    CAPTURE_EVENT_RELAY_OFF,
+    CAPTURE_EVENT_ALARM_FRAME,
+    CAPTURE_EVENT_ITLK_FRAME,
+    CAPTURE_EVENT_END
+}capture_event_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void CaptureInit(uint16_t channel_mask, uint16_t pre_trigger, uint16_t post_trigger);
+extern void CaptureSample(const uint32_t *adc0, const uint32_t *adc1);
+extern void CaptureTrigger(void);
+extern void CaptureArm(void);
+extern bool CaptureRequest(uint8_t cmd, uint16_t index, uint32_t value);
+extern void CaptureTransfer(void);
+extern capture_state_t CaptureStateRead(void);
+extern void CaptureReplay(uint32_t *adc0, uint32_t *adc1);
+extern unsigned char CaptureReplaySync(void);
+extern void CaptureEvent(capture_event_t event);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* CAPTURE_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,228 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file config_store.c
+ * @brief Persistent configuration in the internal EEPROM.
+ *
+ * ConfigLoad() runs once in AppConfiguration(), after config_module_*() has
+ * written the compiled defaults, and reads the whole image with a single
+ * EEPROMRead(). The defaults key makes a firmware with other compiled
+ * defaults (another family or retuned limits) start from its own values.
+ *
+ * The key is kept per entry, so an image saved by a firmware with a shorter
+ * or longer parameter table still loads its common prefix: entries appended
+ * to parameters.c keep their compiled defaults. An entry whose compiled
+ * default changed, or whose stored value the parameter service refuses, keeps
+ * its default while the others (ADC offsets and gains included) still load,
+ * and the load reports CONFIG_PARTIAL. Only a new CONFIG_VERSION or a bad
+ * CRC discards the whole image.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/eeprom.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "config_store.h"
+#include "parameters.h"
+#include "fault_log.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t Count;
+    uint8_t  DefaultsKey[CONFIG_MAX_PARAMS];
+    uint32_t Value[CONFIG_MAX_PARAMS];
+    uint32_t Crc;
+} config_image_t;
+
+// A imagem precisa terminar antes do log de eventos na mesma EEPROM
+typedef char config_image_fits_t[(CONFIG_EEPROM_ADDRESS + sizeof(config_image_t) <= FAULT_LOG_EEPROM_ADDRESS) ? 1 : -1];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Fora da pilha: a imagem e maior que a pilha inteira
+static config_image_t image;
+
+static uint8_t defaults_key[CONFIG_MAX_PARAMS];
+
+static bool eeprom_ready = 0;
+
+static config_status_t config_status = CONFIG_EMPTY;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t config_crc(const uint8_t *data, uint32_t len, uint32_t crc)
+{
+    uint8_t bit;
+
+    while(len--)
+    {
+        crc ^= *data++;
+
+        for(bit = 0; bit < 8; bit++)
+        {
+            if(crc & 1) crc = (crc >> 1) ^ 0xEDB88320;
+            else crc >>= 1;
+        }
+    }
+
+    return crc;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t config_image_crc(void)
+{
+    return ~config_crc((const uint8_t *)&image, sizeof(image) - sizeof(image.Crc), 0xFFFFFFFF);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t config_entry_key(uint32_t value)
+{
+    return (uint8_t)config_crc((const uint8_t *)&value, sizeof(value), 0xFFFFFFFF);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void config_snapshot(void)
+{
+    uint8_t i;
+    uint8_t count = ParamCount();
+
+    for(i = 0; i < CONFIG_MAX_PARAMS; i++)
+    {
+        image.Value[i] = 0;
+        if(i < count) ParamRead(i, &image.Value[i]);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+config_status_t ConfigLoad(void)
+{
+    uint8_t i;
+    uint8_t count;
+    uint8_t kept = 0;
+    uint32_t current;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0));
+
+    if(EEPROMInit() != EEPROM_INIT_OK || ParamCount() > CONFIG_MAX_PARAMS)
+    {
+        config_status = CONFIG_ERROR;
+        return config_status;
+    }
+
+    eeprom_ready = 1;
+
+    // Chave dos valores padrao compilados, antes de aplicar a imagem
+    config_snapshot();
+
+    for(i = 0; i < CONFIG_MAX_PARAMS; i++) defaults_key[i] = config_entry_key(image.Value[i]);
+
+    EEPROMRead((uint32_t *)&image, CONFIG_EEPROM_ADDRESS, sizeof(image));
+
+    if(image.Magic != CONFIG_MAGIC)
+    {
+        config_status = CONFIG_EMPTY;
+        return config_status;
+    }
+
+    if(image.Version != CONFIG_VERSION || image.Count > CONFIG_MAX_PARAMS ||
+       image.Crc != config_image_crc())
+    {
+        config_status = CONFIG_INVALID;
+        return config_status;
+    }
+
+    // Prefixo comum: indices novos ficam com o padrao, removidos sao ignorados
+    count = image.Count;
+    if(count > ParamCount()) count = ParamCount();
+
+    // Cada entrada e decidida sozinha: padrao alterado ou valor recusado pelo
+    // servico de parametros mantem o padrao compilado apenas daquele indice
+    IntMasterDisable();
+
+    for(i = 0; i < count; i++)
+    {
+        // Indices reservados nao guardam valor
+        if(ParamRead(i, &current) == PARAM_ERR_INDEX) continue;
+
+        if(image.DefaultsKey[i] != defaults_key[i] || ParamWrite(i, image.Value[i]) != PARAM_OK) kept++;
+    }
+
+    IntMasterEnable();
+
+    config_status = kept ? CONFIG_PARTIAL : CONFIG_LOADED;
+
+    return config_status;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ConfigSave(void)
+{
+    uint8_t i;
+
+    if(!eeprom_ready) return 0;
+
+    config_snapshot();
+
+    image.Magic = CONFIG_MAGIC;
+    image.Version = CONFIG_VERSION;
+    image.Count = ParamCount();
+
+    for(i = 0; i < CONFIG_MAX_PARAMS; i++) image.DefaultsKey[i] = defaults_key[i];
+    image.Crc = config_image_crc();
+
+    if(EEPROMProgram((uint32_t *)&image, CONFIG_EEPROM_ADDRESS, sizeof(image)) != 0) return 0;
+
+    config_status = CONFIG_LOADED;
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ConfigErase(void)
+{
+    uint32_t blank = 0xFFFFFFFF;
+
+    if(!eeprom_ready) return 0;
+
+    // Invalidar o magic basta para o proximo boot usar os valores padrao
+    if(EEPROMProgram(&blank, CONFIG_EEPROM_ADDRESS, sizeof(blank)) != 0) return 0;
+
+    config_status = CONFIG_EMPTY;
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+config_status_t ConfigStatusRead(void)
+{
+    return config_status;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file config_store.h
+ * @brief Persistent configuration in the internal EEPROM.
+ *
+ * The image holds every entry of the parameter service (limits, delays,
+ * interlock enables, ADC offsets and gains) behind a header with magic,
+ * layout version and a key of the compiled default of each entry, and is
+ * closed by a CRC-32. Entries appended to the parameter table keep their
+ * defaults. CONFIG_PARTIAL means the image loaded but some entries kept their
+ * compiled defaults, because the stored value was out of range or the
+ * compiled default changed since it was saved. Only a layout change
+ * (CONFIG_VERSION) or a bad CRC keeps the defaults for the whole image.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_STORE_H_
+#define CONFIG_STORE_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CONFIG_MAGIC                            0x49494243  // "IIBC"
+
+// Incrementar sempre que o cabecalho da imagem ou o significado de um indice mudar
+#define CONFIG_VERSION                          2
+
+// Entradas reservadas na imagem (ParamCount() deve caber aqui)
+#define CONFIG_MAX_PARAMS                       192
+
+// Endereco da imagem na EEPROM, multiplo de 4
+#define CONFIG_EEPROM_ADDRESS                   0x0000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    CONFIG_LOADED = 0,
+    CONFIG_EMPTY,
+    CONFIG_INVALID,
+    CONFIG_ERROR,
+    CONFIG_PARTIAL
+}config_status_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern config_status_t ConfigLoad(void);
+extern bool ConfigSave(void);
+extern bool ConfigErase(void);
+extern config_status_t ConfigStatusRead(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* CONFIG_STORE_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dew_point.c
+ * @brief Dew point of the rack air and condensation risk on the cold plates.
+ *
+ * ln() is taken from the float exponent plus the atanh series of the
+ * mantissa, ln(m) = 2 * (s + s^3/3 + s^5/5 + s^7/7), s = (m - 1) / (m + 1).
+ * With m in [1, 2) the error is below 2e-5, far under the sensor accuracy,
+ * and it costs one division and a few multiplies instead of libm log().
+ *
+ * Only PT100 channels in PT100_HEALTH_OK enter the minimum: a DEGRADED or
+ * RECOVERING channel keeps its last reading, which may be stale. Without a
+ * valid channel or humidity the check holds its state.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "dew_point.h"
+#include "pt100.h"
+#include "BoardTempHum.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define DEW_POINT_B                             17.62
+#define DEW_POINT_C                             243.12
+
+#define DEW_POINT_LN2                           0.69314718
+
+// Abaixo disso o sensor de umidade esta ausente ou com falha
+#define DEW_POINT_RH_MIN                        1.0
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+dew_point_t DewPoint;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t cold_mask = 0;
+
+static float (* const pt100_read[4])(void) =
+{
+    Pt100Ch1Read, Pt100Ch2Read, Pt100Ch3Read, Pt100Ch4Read
+};
+
+static unsigned char (* const pt100_health[4])(void) =
+{
+    Pt100Ch1HealthRead, Pt100Ch2HealthRead, Pt100Ch3HealthRead, Pt100Ch4HealthRead
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static float dew_point_ln(float x)
+{
+    union {
+        float       f;
+        uint32_t    u;
+    } v;
+    int32_t e;
+    float s;
+    float s2;
+
+    v.f = x;
+
+    // x = m * 2^e, com m em [1, 2)
+    e = (int32_t)((v.u >> 23) & 0xFF) - 127;
+    v.u = (v.u & 0x007FFFFF) | 0x3F800000;
+
+    s = (v.f - 1.0) / (v.f + 1.0);
+    s2 = s * s;
+
+    return (float)e * DEW_POINT_LN2 +
+           2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0 + s2 * (1.0 / 7.0))));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void DewPointInit(uint8_t pt100_mask)
+{
+    cold_mask = pt100_mask;
+
+    DewPoint.Value = 0.0;
+    DewPoint.DewPoint = 0.0;
+    DewPoint.AlarmLimit = DEW_POINT_ALM_MARGIN;
+    DewPoint.TripLimit = DEW_POINT_ITLK_MARGIN;
+    DewPoint.Valid = 0;
+    DewPoint.Alarm = 0;
+    DewPoint.Trip = 0;
+    DewPoint.Alarm_Delay_ms = DEW_POINT_DELAY;
+    DewPoint.Alarm_DelayCount = 0;
+    DewPoint.Itlk_Delay_ms = DEW_POINT_DELAY;
+    DewPoint.Itlk_DelayCount = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void DewPointUpdate(void)
+{
+    float rh = RhRead();
+    float t = BoardTempRead();
+    float cold = 0.0;
+    float g;
+    bool found = 0;
+    uint8_t i;
+
+    for(i = 0; i < 4; i++)
+    {
+        // Fora de PT100_HEALTH_OK o canal guarda a ultima leitura, que pode estar velha
+        if(!(cold_mask & (1 << i)) || pt100_health[i]() != PT100_HEALTH_OK) continue;
+
+        if(!found || pt100_read[i]() < cold) cold = pt100_read[i]();
+
+        found = 1;
+    }
+
+    DewPoint.Valid = found && rh >= DEW_POINT_RH_MIN;
+
+    if(!DewPoint.Valid) return;
+
+    if(rh > 100.0) rh = 100.0;
+
+    g = dew_point_ln(rh / 100.0) + DEW_POINT_B * t / (DEW_POINT_C + t);
+
+    DewPoint.DewPoint = DEW_POINT_C * g / (DEW_POINT_B - g);
+    DewPoint.Value = cold - DewPoint.DewPoint;
+
+    if(DewPoint.AlarmLimit > 0.0 && DewPoint.Value < DewPoint.AlarmLimit)
+    {
+        if(DewPoint.Alarm_DelayCount < DewPoint.Alarm_Delay_ms) DewPoint.Alarm_DelayCount++;
+        else
+        {
+           DewPoint.Alarm_DelayCount = 0;
+           DewPoint.Alarm = 1;
+        }
+    }
+    else DewPoint.Alarm_DelayCount = 0;
+
+    if(DewPoint.TripLimit > 0.0 && DewPoint.Value < DewPoint.TripLimit)
+    {
+        if(DewPoint.Itlk_DelayCount < DewPoint.Itlk_Delay_ms) DewPoint.Itlk_DelayCount++;
+        else
+        {
+           DewPoint.Itlk_DelayCount = 0;
+           DewPoint.Trip = 1;
+        }
+    }
+    else DewPoint.Itlk_DelayCount = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float DewPointRead(void)
+{
+    return DewPoint.DewPoint;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float DewPointMarginRead(void)
+{
+    return DewPoint.Value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char DewPointAlarmStatusRead(void)
+{
+    return DewPoint.Alarm;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char DewPointTripStatusRead(void)
+{
+    return DewPoint.Trip;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void DewPointClearAlarmTrip(void)
+{
+    DewPoint.Alarm = 0;
+    DewPoint.Trip = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
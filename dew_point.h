@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dew_point.h
+ * @brief Dew point of the rack air and condensation risk on the cold plates.
+ *
+ * The dew point comes from the Si7005 relative humidity and temperature by
+ * the Magnus formula (b = 17.62, c = 243.12 degC):
+ *
+ *   g  = ln(RH / 100) + b * T / (c + T)
+ *   Td = c * g / (b - g)
+ *
+ * and is compared with the coldest of the coolant-side PT100 channels chosen
+ * by the module. The margin Value = T_cold - Td goes through the delayed
+ * alarm / trip check, firing when it drops below the limit; a limit of 0
+ * disables that check. The delays count updates, one per second.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEW_POINT_H_
+#define DEW_POINT_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define DewPointEnable                          1
+
+// Canais PT100 do lado do liquido de refrigeracao
+#define DEW_POINT_PT100_CH1                     0x01
+#define DEW_POINT_PT100_CH2                     0x02
+#define DEW_POINT_PT100_CH3                     0x04
+#define DEW_POINT_PT100_CH4                     0x08
+
+// Margens padrao em degC entre a superficie mais fria e o ponto de orvalho
+#define DEW_POINT_ALM_MARGIN                    3.0
+#define DEW_POINT_ITLK_MARGIN                   1.0
+#define DEW_POINT_DELAY                         5
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    float Value;                  // T_cold - Td, degC
+    float DewPoint;               // Td, degC
+    float AlarmLimit;
+    float TripLimit;
+    unsigned char Valid;
+    unsigned char Alarm;
+    unsigned char Trip;
+    unsigned int  Alarm_Delay_ms; // atualizacoes de 1s
+    unsigned int  Alarm_DelayCount;
+    unsigned int  Itlk_Delay_ms;  // atualizacoes de 1s
+    unsigned int  Itlk_DelayCount;
+}dew_point_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern dew_point_t DewPoint;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void DewPointInit(uint8_t pt100_mask);
+extern void DewPointUpdate(void);
+extern float DewPointRead(void);
+extern float DewPointMarginRead(void);
+extern unsigned char DewPointAlarmStatusRead(void);
+extern unsigned char DewPointTripStatusRead(void);
+extern void DewPointClearAlarmTrip(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* DEW_POINT_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,261 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file fault_log.c
+ * @brief Persistent interlock and alarm event log.
+ *
+ * Records are composed in RAM and programmed by FaultLogService(), one word
+ * per 1ms call with EEPROMProgramNonBlocking(), always from the main loop.
+ * The EEPROM controller does not stall the flash, so the interrupts keep
+ * running from flash while a word is being programmed.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/eeprom.h"
+#include "driverlib/sysctl.h"
+#include "fault_log.h"
+#include "first_fault.h"
+#include "iib_data.h"
+#include "peripheral_drivers/timer/timer.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define FAULT_LOG_RECORD_BYTES                  (FAULT_LOG_RECORD_WORDS * 4)
+#define FAULT_LOG_CRC_WORD                      (FAULT_LOG_RECORD_WORDS - 1)
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool eeprom_ready = 0;
+
+static uint16_t head = 0;
+static uint16_t count = 0;
+static uint32_t next_seq = 0;
+static uint32_t reset_cause = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t queue[FAULT_LOG_QUEUE][FAULT_LOG_RECORD_WORDS];
+static uint8_t  queue_head = 0;
+static uint8_t  queue_tail = 0;
+static uint8_t  write_word = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t itlk_seen = 0;
+static uint32_t alarm_seen = 0;
+
+static bool     event_open = 0;
+static uint32_t event_ms = 0;
+static uint32_t event_signals[FAULT_LOG_SIGNALS];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t fault_log_crc(const uint32_t *record)
+{
+    const uint8_t *data = (const uint8_t *)record;
+    uint32_t len = FAULT_LOG_CRC_WORD * 4;
+    uint32_t crc = 0xFFFFFFFF;
+    uint8_t bit;
+
+    while(len--)
+    {
+        crc ^= *data++;
+
+        for(bit = 0; bit < 8; bit++)
+        {
+            if(crc & 1) crc = (crc >> 1) ^ 0xEDB88320;
+            else crc >>= 1;
+        }
+    }
+
+    return ~crc;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t fault_log_address(uint16_t block)
+{
+    return FAULT_LOG_EEPROM_ADDRESS + (uint32_t)block * FAULT_LOG_RECORD_BYTES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void fault_log_push(fault_log_type_t type, uint32_t uptime, uint32_t itlk, uint32_t alarm,
+                           const uint32_t *signals)
+{
+    uint32_t *record;
+    uint8_t next = (queue_head + 1) % FAULT_LOG_QUEUE;
+    uint8_t i;
+
+    // Fila cheia: o registro e perdido, mas a sequencia acusa a falta
+    if(next == queue_tail)
+    {
+        next_seq++;
+        return;
+    }
+
+    record = queue[queue_head];
+
+    record[0] = next_seq++;
+    record[1] = type;
+    record[2] = uptime;
+    record[3] = reset_cause;
+    record[4] = itlk;
+    record[5] = alarm;
+    record[6] = (type == FAULT_LOG_FAULT) ? g_controller_iib.iib_itlk[FIRST_FAULT_BITS_WORD].u32 : 0;
+    record[7] = (type == FAULT_LOG_FAULT) ? g_controller_iib.iib_alarm[FIRST_FAULT_BITS_WORD].u32 : 0;
+
+    for(i = 0; i < FAULT_LOG_SIGNALS; i++) record[8 + i] = signals ? signals[i] : 0;
+
+    record[FAULT_LOG_CRC_WORD] = fault_log_crc(record);
+
+    queue_head = next;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FaultLogInit(void)
+{
+    uint32_t record[FAULT_LOG_RECORD_WORDS];
+    uint32_t newest = 0;
+    bool found = 0;
+    uint16_t i;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0));
+
+    if(EEPROMInit() != EEPROM_INIT_OK ||
+       EEPROMSizeGet() < fault_log_address(FAULT_LOG_RECORDS)) return;
+
+    // Causa do ultimo reset, limpa para o proximo boot
+    reset_cause = SysCtlResetCauseGet();
+    SysCtlResetCauseClear(reset_cause);
+
+    // O registro valido mais novo define a posicao de escrita e a sequencia
+    for(i = 0; i < FAULT_LOG_RECORDS; i++)
+    {
+        EEPROMRead(record, fault_log_address(i), FAULT_LOG_RECORD_BYTES);
+
+        if(record[FAULT_LOG_CRC_WORD] != fault_log_crc(record)) continue;
+
+        count++;
+
+        if(!found || (int32_t)(record[0] - newest) > 0)
+        {
+            found = 1;
+            newest = record[0];
+            head = (i + 1) % FAULT_LOG_RECORDS;
+        }
+    }
+
+    if(found) next_seq = newest + 1;
+
+    eeprom_ready = 1;
+
+    fault_log_push(FAULT_LOG_BOOT, get_millis(), 0, 0, 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FaultLogUpdate(uint32_t itlk, uint32_t alarm)
+{
+    bool new_bits = (itlk & ~itlk_seen) || (alarm & ~alarm_seen);
+    uint8_t i;
+
+    // Acompanha tambem o clear, para o proximo evento abrir um novo registro
+    itlk_seen = itlk;
+    alarm_seen = alarm;
+
+    if(!eeprom_ready) return;
+
+    // Valores dos sinais no primeiro bit, mascaras ao fechar o registro
+    if(new_bits && !event_open)
+    {
+        event_open = 1;
+        event_ms = get_millis();
+
+        for(i = 0; i < FAULT_LOG_SIGNALS; i++) event_signals[i] = g_controller_iib.iib_signals[i].u32;
+    }
+
+    if(event_open && (get_millis() - event_ms) >= FAULT_LOG_SETTLE_MS)
+    {
+        event_open = 0;
+
+        fault_log_push(FAULT_LOG_FAULT, event_ms, itlk, alarm, event_signals);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FaultLogService(void)
+{
+    if(!eeprom_ready || queue_tail == queue_head) return;
+
+    // Palavra anterior ainda sendo gravada
+    if(EEPROMStatusGet() & EEPROM_RC_WORKING) return;
+
+    EEPROMProgramNonBlocking(queue[queue_tail][write_word], fault_log_address(head) + write_word * 4);
+
+    if(++write_word < FAULT_LOG_RECORD_WORDS) return;
+
+    write_word = 0;
+
+    head = (head + 1) % FAULT_LOG_RECORDS;
+    if(count < FAULT_LOG_RECORDS) count++;
+
+    queue_tail = (queue_tail + 1) % FAULT_LOG_QUEUE;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t FaultLogCount(void)
+{
+    return count;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t FaultLogNextSeq(void)
+{
+    return next_seq;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool FaultLogRead(uint16_t record, uint8_t word, uint32_t *value)
+{
+    uint16_t block;
+
+    if(!eeprom_ready || record >= count || word >= FAULT_LOG_RECORD_WORDS)
+    {
+        *value = 0xFFFFFFFF;
+        return 1;
+    }
+
+    // Leitura so com a EEPROM livre; o cursor tenta de novo na proxima chamada
+    if(EEPROMStatusGet() & EEPROM_RC_WORKING) return 0;
+
+    // record 0 e o mais antigo
+    block = (head + FAULT_LOG_RECORDS - count + record) % FAULT_LOG_RECORDS;
+
+    EEPROMRead(value, fault_log_address(block) + word * 4, 4);
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file fault_log.h
+ * @brief Persistent interlock and alarm event log.
+ *
+ * Append-only ring of fixed records in the internal EEPROM, after the
+ * configuration image. Each record takes one 64-byte EEPROM block and the
+ * ring walks every block in turn, so all blocks wear at the same rate. A boot
+ * record with the reset cause is written on every power-up, and one record per
+ * fault event: it opens on the first new interlock or alarm bit and is closed
+ * FAULT_LOG_SETTLE_MS later, so a cascade lands in a single record.
+ *
+ * Record words:
+ * [0] sequence number, [1] type (fault_log_type_t), [2] uptime in ms at the
+ * first bit, [3] reset cause of this boot, [4] interlock word, [5] alarm word,
+ * [6] first interlock bits, [7] first alarm bits, [8..14] iib_signals[0..6]
+ * at the first bit, [15] CRC-32 of words 0..14.
+ *
+ * A record cut by a brownout fails the CRC and is skipped on the next boot.
+ * Read back with CAPTURE_CMD_LOG_STATUS / CAPTURE_CMD_LOG_READ.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FAULT_LOG_H_
+#define FAULT_LOG_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Regiao do log na EEPROM: apos a imagem de configuracao ate o fim dos 6KB
+#define FAULT_LOG_EEPROM_ADDRESS                0x0400
+#define FAULT_LOG_RECORDS                       80
+
+#define FAULT_LOG_RECORD_WORDS                  16
+#define FAULT_LOG_SIGNALS                       7
+
+// Espera apos o primeiro bit antes de fechar o registro
+#define FAULT_LOG_SETTLE_MS                     200
+
+// Registros aguardando gravacao
+#define FAULT_LOG_QUEUE                         4
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    FAULT_LOG_BOOT = 1,
+    FAULT_LOG_FAULT
+}fault_log_type_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void FaultLogInit(void);
+extern void FaultLogUpdate(uint32_t itlk, uint32_t alarm);
+extern void FaultLogService(void);
+extern uint16_t FaultLogCount(void);
+extern uint32_t FaultLogNextSeq(void);
+extern bool FaultLogRead(uint16_t record, uint8_t word, uint32_t *value);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* FAULT_LOG_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
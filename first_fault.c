@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file first_fault.c
+ * @brief First-fault register of the interlock and alarm words.
+ *
+ * FirstFaultUpdate() runs right after the module readings, which is where the
+ * trip flags become bits of the words, so the timestamp is taken in the same
+ * pass that sets the bit. Everything runs in the main loop.
+ *
+ * The pending masks are the single send queue of the interlock and alarm
+ * objects: a send request only sets the bit of its word and tries one frame
+ * right away, the rest goes out from FirstFaultService() every 1ms.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "first_fault.h"
+#include "can_bus.h"
+#include "can_health.h"
+#include "iib_data.h"
+#include "peripheral_drivers/timer/timer.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define FIRST_FAULT_ITLK_WORDS                  (FIRST_FAULT_SEQ_WORD + FIRST_FAULT_SEQ_LEN)
+#define FIRST_FAULT_ALARM_WORDS                 (FIRST_FAULT_TIME_WORD + 1)
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t itlk_seen = 0;
+static uint32_t alarm_seen = 0;
+
+static bool event_open = 0;
+static uint32_t event_us = 0;
+static uint8_t seq_count = 0;
+
+// Palavras ainda nao publicadas, bit n = palavra n
+static uint32_t itlk_pending = 0;
+static uint32_t alarm_pending = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void first_fault_log(uint8_t bit, bool alarm, uint32_t delta)
+{
+    uint32_t entry;
+
+    if(delta > FIRST_FAULT_DELTA_MAX) delta = FIRST_FAULT_DELTA_MAX;
+
+    entry = bit | (delta << 8);
+    if(alarm) entry |= FIRST_FAULT_SEQ_ALARM;
+
+    if(seq_count < FIRST_FAULT_SEQ_LEN)
+    {
+        g_controller_iib.iib_itlk[FIRST_FAULT_SEQ_WORD + seq_count].u32 = entry;
+        itlk_pending |= 1UL << (FIRST_FAULT_SEQ_WORD + seq_count);
+    }
+
+    if(seq_count < 255) seq_count++;
+
+    g_controller_iib.iib_itlk[FIRST_FAULT_COUNT_WORD].u32 = seq_count;
+    itlk_pending |= 1UL << FIRST_FAULT_COUNT_WORD;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void first_fault_seq(uint32_t bits, bool alarm, uint32_t delta)
+{
+    uint8_t i;
+
+    for(i = 0; i < 32; i++)
+    {
+        if(bits & (1UL << i)) first_fault_log(i, alarm, delta);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FirstFaultUpdate(uint32_t itlk, uint32_t alarm)
+{
+    uint32_t new_itlk = itlk & ~itlk_seen;
+    uint32_t new_alarm = alarm & ~alarm_seen;
+    uint32_t now;
+    bool opening;
+
+    if(!new_itlk && !new_alarm) return;
+
+    now = get_micros();
+
+    itlk_seen |= new_itlk;
+    alarm_seen |= new_alarm;
+
+    opening = !event_open;
+
+    if(opening)
+    {
+        event_open = 1;
+        event_us = now;
+    }
+
+    // Primeiro interlock e primeiro alarme congelados uma unica vez
+    if(new_itlk && g_controller_iib.iib_itlk[FIRST_FAULT_BITS_WORD].u32 == 0)
+    {
+        g_controller_iib.iib_itlk[FIRST_FAULT_BITS_WORD].u32 = new_itlk;
+        g_controller_iib.iib_itlk[FIRST_FAULT_TIME_WORD].u32 = now;
+        itlk_pending |= (1UL << FIRST_FAULT_BITS_WORD) | (1UL << FIRST_FAULT_TIME_WORD);
+    }
+
+    if(new_alarm && g_controller_iib.iib_alarm[FIRST_FAULT_BITS_WORD].u32 == 0)
+    {
+        g_controller_iib.iib_alarm[FIRST_FAULT_BITS_WORD].u32 = new_alarm;
+        g_controller_iib.iib_alarm[FIRST_FAULT_TIME_WORD].u32 = now;
+        alarm_pending |= (1UL << FIRST_FAULT_BITS_WORD) | (1UL << FIRST_FAULT_TIME_WORD);
+    }
+
+    // A passagem que abriu o evento e a propria primeira falha
+    if(opening) return;
+
+    first_fault_seq(new_itlk, 0, now - event_us);
+    first_fault_seq(new_alarm, 1, now - event_us);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FirstFaultClear(void)
+{
+    uint8_t i;
+
+    for(i = FIRST_FAULT_BITS_WORD; i < FIRST_FAULT_ITLK_WORDS; i++) g_controller_iib.iib_itlk[i].u32 = 0;
+    for(i = FIRST_FAULT_BITS_WORD; i < FIRST_FAULT_ALARM_WORDS; i++) g_controller_iib.iib_alarm[i].u32 = 0;
+
+    itlk_seen = 0;
+    alarm_seen = 0;
+
+    event_open = 0;
+    seq_count = 0;
+
+    // O registro zerado tambem e publicado, sem perder as palavras na fila
+    itlk_pending |= ((1UL << FIRST_FAULT_ITLK_WORDS) - 1) & ~((1UL << FIRST_FAULT_BITS_WORD) - 1);
+    alarm_pending |= ((1UL << FIRST_FAULT_ALARM_WORDS) - 1) & ~((1UL << FIRST_FAULT_BITS_WORD) - 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FirstFaultItlkSend(uint8_t word)
+{
+    if(word >= 32) return;
+
+    itlk_pending |= 1UL << word;
+
+    FirstFaultService();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FirstFaultAlarmSend(uint8_t word)
+{
+    if(word >= 32) return;
+
+    alarm_pending |= 1UL << word;
+
+    FirstFaultService();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void FirstFaultService(void)
+{
+    uint8_t i;
+
+    // Um quadro por chamada e so com o objeto livre, para nao sobrescrever iib_itlk[0]
+    if(itlk_pending && !CanHealthTxBusy(MESSAGE_ITLK_IIB_OBJ_ID))
+    {
+        for(i = 0; !(itlk_pending & (1UL << i)); i++);
+
+        itlk_pending &= ~(1UL << i);
+
+        send_itlk_message(i);
+    }
+    else if(alarm_pending && !CanHealthTxBusy(MESSAGE_ALARM_IIB_OBJ_ID))
+    {
+        for(i = 0; !(alarm_pending & (1UL << i)); i++);
+
+        alarm_pending &= ~(1UL << i);
+
+        send_alarm_message(i);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
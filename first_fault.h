@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file first_fault.h
+ * @brief First-fault register of the interlock and alarm words.
+ *
+ * The interlock and alarm words latch every bit until the reset message, so
+ * after a cascade they do not show which fault started it. This register
+ * freezes the bits of the first interlock and of the first alarm with a
+ * microsecond timestamp and then logs, in order, the next faults of the same
+ * event with their time relative to the first one.
+ *
+ * The record lives next to the live words and goes out on the same frames
+ * (byte [1] is the word index):
+ *   iib_itlk[2]  first interlock bits      iib_alarm[2]  first alarm bits
+ *   iib_itlk[3]  its get_micros() stamp    iib_alarm[3]  its get_micros() stamp
+ *   iib_itlk[4]  faults seen after the first one, saturated at 255
+ *   iib_itlk[5..] sequence: [4:0] bit, [5] 1 = alarm, [7:6] 0, [31:8] us after
+ *                 the first fault, saturated at 0xFFFFFF
+ * Bits that appear in the same readings pass as the first fault are frozen
+ * together, since their order inside the pass is not known.
+ *
+ * The stamps are taken when the readings pass of the main loop sees the bit,
+ * not when the trip flag was set: they can lag the flag by one main loop
+ * pass, bounded by the longest BoardTask slot. Deltas below that are not
+ * meaningful.
+ *
+ * Every frame on the interlock and alarm objects, the live word 0 and the
+ * reset reply included, goes through FirstFaultItlkSend() and
+ * FirstFaultAlarmSend(). A word is only loaded into a free object, lowest
+ * index first, so no queued word is overwritten before it leaves.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FIRST_FAULT_H_
+#define FIRST_FAULT_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Palavras de iib_itlk[] e iib_alarm[] usadas pelo registro
+#define FIRST_FAULT_BITS_WORD                   2
+#define FIRST_FAULT_TIME_WORD                   3
+#define FIRST_FAULT_COUNT_WORD                  4
+#define FIRST_FAULT_SEQ_WORD                    5
+
+// Falhas seguintes guardadas em ordem
+#define FIRST_FAULT_SEQ_LEN                     8
+
+#define FIRST_FAULT_SEQ_ALARM                   0x00000020
+#define FIRST_FAULT_DELTA_MAX                   0x00FFFFFF
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void FirstFaultUpdate(uint32_t itlk, uint32_t alarm);
+extern void FirstFaultClear(void);
+extern void FirstFaultItlkSend(uint8_t word);
+extern void FirstFaultAlarmSend(uint8_t word);
+extern void FirstFaultService(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* FIRST_FAULT_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
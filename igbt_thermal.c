@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file igbt_thermal.c
+ * @brief IGBT junction temperature estimated from the arm current.
+ *
+ * IgbtThermalSample() runs in the 1ms interrupt: per IGBT one loss estimate
+ * and IGBT_THERMAL_ORDER multiply-adds, no exp() and no division. The current
+ * is the channel Value refreshed by the 100us samples; the NTC value is the
+ * last one read by NtcRead().
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "igbt_thermal.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+igbt_thermal_t TempJunctionIgbt1;
+igbt_thermal_t TempJunctionIgbt2;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    const float *current;
+    const float *ntc;
+    float k_lin;                        // W/A
+    float k_sq;                         // W/A^2
+    float a[IGBT_THERMAL_ORDER];
+    float b[IGBT_THERMAL_ORDER];
+    float rise[IGBT_THERMAL_ORDER];     // K acima do NTC por elemento
+}igbt_thermal_state_t;
+
+static igbt_thermal_state_t state[IGBT_THERMAL_NUM];
+
+static igbt_thermal_t * const junction[IGBT_THERMAL_NUM] =
+{
+    &TempJunctionIgbt1, &TempJunctionIgbt2
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void IgbtThermalInit(uint8_t igbt, const igbt_thermal_model_t *model,
+                     const float *current, const float *ntc)
+{
+    igbt_thermal_state_t *s;
+    uint8_t k;
+
+    if(igbt >= IGBT_THERMAL_NUM) return;
+
+    s = &state[igbt];
+
+    // Sem corrente o modelo fica parado
+    s->current = 0;
+
+    s->k_lin = model->Vce0 * model->Duty + model->Ksw;
+    s->k_sq = model->Rce * model->Duty;
+
+    for(k = 0; k < IGBT_THERMAL_ORDER; k++)
+    {
+        s->a[k] = expf(-IGBT_THERMAL_STEP_S / model->Tau[k]);
+        s->b[k] = model->Rth[k] * (1.0 - s->a[k]);
+        s->rise[k] = 0.0;
+    }
+
+    junction[igbt]->Value = 0.0;
+    junction[igbt]->Alarm = 0;
+    junction[igbt]->Trip = 0;
+    junction[igbt]->Alarm_DelayCount = 0;
+    junction[igbt]->Itlk_DelayCount = 0;
+
+    s->ntc = ntc;
+    s->current = current;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void IgbtThermalSample(void)
+{
+    igbt_thermal_state_t *s;
+    igbt_thermal_t *tj;
+    float i;
+    float loss;
+    float rise;
+    uint8_t n;
+    uint8_t k;
+
+    for(n = 0; n < IGBT_THERMAL_NUM; n++)
+    {
+        s = &state[n];
+        tj = junction[n];
+
+        if(s->current == 0) continue;
+
+        i = *s->current;
+        if(i < 0.0) i = -i;
+
+        loss = (s->k_lin + s->k_sq * i) * i;
+
+        rise = 0.0;
+
+        for(k = 0; k < IGBT_THERMAL_ORDER; k++)
+        {
+            s->rise[k] = s->a[k] * s->rise[k] + s->b[k] * loss;
+            rise += s->rise[k];
+        }
+
+        tj->Value = *s->ntc + rise;
+
+        if(tj->AlarmLimit > 0.0 && tj->Value > tj->AlarmLimit)
+        {
+            if(tj->Alarm_DelayCount < tj->Alarm_Delay_ms) tj->Alarm_DelayCount++;
+            else
+            {
+               tj->Alarm_DelayCount = 0;
+               tj->Alarm = 1;
+            }
+        }
+        else tj->Alarm_DelayCount = 0;
+
+        if(tj->TripLimit > 0.0 && tj->Value > tj->TripLimit)
+        {
+            if(tj->Itlk_DelayCount < tj->Itlk_Delay_ms) tj->Itlk_DelayCount++;
+            else
+            {
+               tj->Itlk_DelayCount = 0;
+               tj->Trip = 1;
+            }
+        }
+        else tj->Itlk_DelayCount = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float IgbtJunctionRead(uint8_t igbt)
+{
+    if(igbt >= IGBT_THERMAL_NUM) return 0.0;
+
+    return junction[igbt]->Value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void IgbtJunctionAlarmLevelSet(uint8_t igbt, float nValue)
+{
+    if(igbt < IGBT_THERMAL_NUM) junction[igbt]->AlarmLimit = nValue;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void IgbtJunctionTripLevelSet(uint8_t igbt, float nValue)
+{
+    if(igbt < IGBT_THERMAL_NUM) junction[igbt]->TripLimit = nValue;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void IgbtJunctionDelay(uint8_t igbt, unsigned int delay_ms)
+{
+    if(igbt >= IGBT_THERMAL_NUM) return;
+
+    junction[igbt]->Alarm_Delay_ms = delay_ms;
+    junction[igbt]->Itlk_Delay_ms = delay_ms;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char IgbtJunctionAlarmStatusRead(uint8_t igbt)
+{
+    if(igbt >= IGBT_THERMAL_NUM) return 0;
+
+    return junction[igbt]->Alarm;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char IgbtJunctionTripStatusRead(uint8_t igbt)
+{
+    if(igbt >= IGBT_THERMAL_NUM) return 0;
+
+    return junction[igbt]->Trip;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void IgbtThermalClearAlarmTrip(void)
+{
+    uint8_t n;
+
+    for(n = 0; n < IGBT_THERMAL_NUM; n++)
+    {
+        junction[n]->Alarm = 0;
+        junction[n]->Trip = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
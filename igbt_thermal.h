@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file igbt_thermal.h
+ * @brief IGBT junction temperature estimated from the arm current.
+ *
+ * The NTC of each IGBT module is read once a second and sits on the
+ * baseplate, seconds behind the junction. This model adds the rise of the
+ * junction over the NTC: the losses are estimated from the arm current every
+ * millisecond and drive a Foster RC network of IGBT_THERMAL_ORDER elements,
+ * each one a first order lag with its own Rth and tau:
+ *
+ *   P   = (Vce0 * Duty + Ksw) * |i| + Rce * Duty * i^2
+ *   dTk = ak * dTk + bk * P,  ak = exp(-1ms / tauk),  bk = Rthk * (1 - ak)
+ *   Tj  = T_ntc + sum(dTk)
+ *
+ * Duty is the fraction of the time the IGBT carries the arm current (1.0 is
+ * the conservative choice) and Ksw the switching loss per ampere,
+ * Ksw = (Eon + Eoff) * fsw / Iref. ak and bk are computed once at init.
+ *
+ * The estimate has its own alarm and trip limits, with the delays in ms; a
+ * limit of 0 disables that check.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IGBT_THERMAL_H_
+#define IGBT_THERMAL_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define IgbtThermalEnable                       1
+
+#define IGBT_THERMAL_ORDER                      4
+
+// Passo do modelo, o mesmo da chamada em task_1_ms()
+#define IGBT_THERMAL_STEP_S                     0.001
+
+#define IGBT_THERMAL_IGBT1                      0
+#define IGBT_THERMAL_IGBT2                      1
+#define IGBT_THERMAL_NUM                        2
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    float Vce0;                         // V
+    float Rce;                          // ohm
+    float Ksw;                          // W/A
+    float Duty;
+    float Rth[IGBT_THERMAL_ORDER];      // K/W, juncao ate o NTC
+    float Tau[IGBT_THERMAL_ORDER];      // s
+}igbt_thermal_model_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    float Value;
+    float AlarmLimit;
+    float TripLimit;
+    unsigned char Alarm;
+    unsigned char Trip;
+    unsigned int  Alarm_Delay_ms; // milisecond
+    unsigned int  Alarm_DelayCount;
+    unsigned int  Itlk_Delay_ms; // milisecond
+    unsigned int  Itlk_DelayCount;
+}igbt_thermal_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern igbt_thermal_t TempJunctionIgbt1;
+extern igbt_thermal_t TempJunctionIgbt2;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void IgbtThermalInit(uint8_t igbt, const igbt_thermal_model_t *model,
+                            const float *current, const float *ntc);
+extern void IgbtThermalSample(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern float IgbtJunctionRead(uint8_t igbt);
+extern void IgbtJunctionAlarmLevelSet(uint8_t igbt, float nValue);
+extern void IgbtJunctionTripLevelSet(uint8_t igbt, float nValue);
+extern void IgbtJunctionDelay(uint8_t igbt, unsigned int delay_ms);
+extern unsigned char IgbtJunctionAlarmStatusRead(uint8_t igbt);
+extern unsigned char IgbtJunctionTripStatusRead(uint8_t igbt);
+extern void IgbtThermalClearAlarmTrip(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* IGBT_THERMAL_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,8 @@
 #include "BoardTempHum.h"
 #include "ntc_isolated_i2c.h"
 #include "pt100.h"
+#include "temp_slope.h"
+#include "dew_point.h"
 #include "output.h"
 #include "leds.h"
 #include "can_bus.h"
@@ -49,78 +51,50 @@ fac_cmd_t fac_cmd;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t fac_cmd_interlocks_indication;
-static uint32_t fac_cmd_alarms_indication;
+// Deadband absoluto, deadband relativo e periodo de envio de cada sinal
+const telemetry_signal_cfg_t fac_cmd_telemetry_cfg[FAC_CMD_NUM_SIGNALS] =
+{
+    { 1.0,  0.01,  1000 },   //  0 VcapBank
+    { 1.0,  0.01,  1000 },   //  1 Vout
+    { 0.1,  0.01,  1000 },   //  2 AuxIdbVoltage
+    { 0.05, 0.01,  1000 },   //  3 AuxCurrent
+    { 0.05, 0.01,  1000 },   //  4 IdbCurrent
+    { 0.5,  0.01,  1000 },   //  5 GroundLeakage
+    { 0.5,  0.0,   5000 },   //  6 TempL
+    { 0.5,  0.0,   5000 },   //  7 TempHeatSink
+    { 0.5,  0.0,  10000 },   //  8 BoardTemperature
+    { 1.0,  0.0,  10000 },   //  9 RelativeHumidity
+    { 0.5,  0.0,  10000 }    // 10 DewPoint
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
 
 static uint32_t ResetInterlocksRegister = 0;
 static uint32_t ResetAlarmsRegister = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t itlk_id;
 static uint32_t alarm_id;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void clear_fac_cmd_interlocks()
 {
-    fac_cmd.VcapBankItlkSts         = 0;
-    fac_cmd.VoutItlkSts             = 0;
-    fac_cmd.AuxIdbVoltageItlkSts    = 0;
-    fac_cmd.AuxCurrentItlkSts       = 0;
-    fac_cmd.IdbCurrentItlkSts       = 0;
-    fac_cmd.MainOverCurrentItlkSts  = 0;
-    fac_cmd.EmergencyButtonItlkSts  = 0;
-    fac_cmd.MainUnderVoltageItlkSts = 0;
-    fac_cmd.MainOverVoltageItlkSts  = 0;
-    fac_cmd.GroundLeakageItlkSts    = 0;
-    fac_cmd.TempLItlkSts            = 0;
-    fac_cmd.TempHeatSinkItlkSts     = 0;
-    fac_cmd.BoardTemperatureItlkSts = 0;
-    fac_cmd.RelativeHumidityItlkSts = 0;
-
-    itlk_id = 0;
-
+    fac_cmd.ItlkSts = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 uint8_t check_fac_cmd_interlocks()
 {
-    uint8_t test = 0;
-
-    test |= fac_cmd.VcapBankItlkSts;
-    test |= fac_cmd.VoutItlkSts;
-    test |= fac_cmd.AuxIdbVoltageItlkSts;
-    test |= fac_cmd.AuxCurrentItlkSts;
-    test |= fac_cmd.IdbCurrentItlkSts;
-    test |= fac_cmd.MainOverCurrentItlkSts;
-    test |= fac_cmd.EmergencyButtonItlkSts;
-    test |= fac_cmd.MainUnderVoltageItlkSts;
-    test |= fac_cmd.MainOverVoltageItlkSts;
-    test |= fac_cmd.GroundLeakageItlkSts;
-    test |= fac_cmd.TempLItlkSts;
-    test |= fac_cmd.TempHeatSinkItlkSts;
-    test |= fac_cmd.BoardTemperatureItlkSts;
-    test |= fac_cmd.RelativeHumidityItlkSts;
-
-    return test;
+    return (fac_cmd.ItlkSts != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void clear_fac_cmd_alarms()
 {
-    fac_cmd.VcapBankAlarmSts            = 0;
-    fac_cmd.VoutAlarmSts                = 0;
-    fac_cmd.AuxIdbVoltageAlarmSts       = 0;
-    fac_cmd.AuxCurrentAlarmSts          = 0;
-    fac_cmd.IdbCurrentAlarmSts          = 0;
-    fac_cmd.GroundLeakageAlarmSts       = 0;
-    fac_cmd.TempLAlarmSts               = 0;
-    fac_cmd.TempHeatSinkAlarmSts        = 0;
-    fac_cmd.BoardTemperatureAlarmSts    = 0;
-    fac_cmd.RelativeHumidityAlarmSts    = 0;
+    fac_cmd.AlarmSts = 0;
 
     alarm_id = 0;
 
@@ -130,20 +104,7 @@ void clear_fac_cmd_alarms()
 
 uint8_t check_fac_cmd_alarms()
 {
-    uint8_t test = 0;
-
-    test |= fac_cmd.VcapBankAlarmSts;
-    test |= fac_cmd.VoutAlarmSts;
-    test |= fac_cmd.AuxIdbVoltageAlarmSts;
-    test |= fac_cmd.AuxCurrentAlarmSts;
-    test |= fac_cmd.IdbCurrentAlarmSts;
-    test |= fac_cmd.GroundLeakageAlarmSts;
-    test |= fac_cmd.TempLAlarmSts;
-    test |= fac_cmd.TempHeatSinkAlarmSts;
-    test |= fac_cmd.BoardTemperatureAlarmSts;
-    test |= fac_cmd.RelativeHumidityAlarmSts;
-
-    return test;
+    return (fac_cmd.AlarmSts != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -151,62 +112,62 @@ uint8_t check_fac_cmd_alarms()
 void check_fac_cmd_indication_leds()
 {
     //Input over voltage
-    if(fac_cmd.VcapBankItlkSts) Led2TurnOff();
-    else if(fac_cmd.VcapBankAlarmSts) Led2Toggle();
+    if(fac_cmd.ItlkSts & FAC_CMD_CAPBANK_OVERVOLTAGE_ITLK) Led2TurnOff();
+    else if(fac_cmd.AlarmSts & FAC_CMD_CAPBANK_OVERVOLTAGE_ALM) Led2Toggle();
     else Led2TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Output over voltage
-    if(fac_cmd.VoutItlkSts) Led3TurnOff();
-    else if(fac_cmd.VoutAlarmSts) Led3Toggle();
+    if(fac_cmd.ItlkSts & FAC_CMD_OUTPUT_OVERVOLTAGE_ITLK) Led3TurnOff();
+    else if(fac_cmd.AlarmSts & FAC_CMD_OUTPUT_OVERVOLTAGE_ALM) Led3Toggle();
     else Led3TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks Aux and Idb voltage and current
-    if(fac_cmd.AuxIdbVoltageItlkSts || fac_cmd.AuxCurrentItlkSts || fac_cmd.IdbCurrentItlkSts) Led4TurnOff();
-    else if(fac_cmd.AuxIdbVoltageAlarmSts || fac_cmd.AuxCurrentAlarmSts || fac_cmd.IdbCurrentAlarmSts) Led4Toggle();
+    if(fac_cmd.ItlkSts & (FAC_CMD_AUX_AND_IDB_SUPPLY_OVERVOLTAGE_ITLK | FAC_CMD_AUX_SUPPLY_OVERCURRENT_ITLK | FAC_CMD_IDB_SUPPLY_OVERCURRENT_ITLK)) Led4TurnOff();
+    else if(fac_cmd.AlarmSts & (FAC_CMD_AUX_AND_IDB_SUPPLY_OVERVOLTAGE_ALM | FAC_CMD_AUX_SUPPLY_OVERCURRENT_ALM | FAC_CMD_IDB_SUPPLY_OVERCURRENT_ALM)) Led4Toggle();
     else Led4TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks main over current and emergency button
-    if(fac_cmd.MainOverCurrentItlkSts || fac_cmd.EmergencyButtonItlkSts) Led5TurnOff();
+    if(fac_cmd.ItlkSts & (FAC_CMD_MAIN_OVER_CURRENT_ITLK | FAC_CMD_EMERGENCY_BUTTON_ITLK)) Led5TurnOff();
     else Led5TurnOn();
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks main under voltage and main over voltage
-    if(fac_cmd.MainUnderVoltageItlkSts || fac_cmd.MainOverVoltageItlkSts) Led6TurnOff();
+    if(fac_cmd.ItlkSts & (FAC_CMD_MAIN_UNDER_VOLTAGE_ITLK | FAC_CMD_MAIN_OVER_VOLTAGE_ITLK)) Led6TurnOff();
     else Led6TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Fuga para o Terra
-    if(fac_cmd.GroundLeakageItlkSts) Led7TurnOff();
-    else if(fac_cmd.GroundLeakageAlarmSts) Led7Toggle();
+    if(fac_cmd.ItlkSts & FAC_CMD_GROUND_LKG_ITLK) Led7TurnOff();
+    else if(fac_cmd.AlarmSts & FAC_CMD_GROUND_LKG_ALM) Led7Toggle();
     else Led7TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Heatsink Over temperature
-    if(fac_cmd.TempHeatSinkItlkSts) Led8TurnOff();
-    else if(fac_cmd.TempHeatSinkAlarmSts) Led8Toggle();
+    if(fac_cmd.ItlkSts & FAC_CMD_HS_OVERTEMP_ITLK) Led8TurnOff();
+    else if(fac_cmd.AlarmSts & FAC_CMD_HS_OVERTEMP_ALM) Led8Toggle();
     else Led8TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Inductor Over temperature
-    if(fac_cmd.TempLItlkSts) Led9TurnOff();
-    else if(fac_cmd.TempLAlarmSts) Led9Toggle();
+    if(fac_cmd.ItlkSts & FAC_CMD_INDUC_OVERTEMP_ITLK) Led9TurnOff();
+    else if(fac_cmd.AlarmSts & FAC_CMD_INDUC_OVERTEMP_ALM) Led9Toggle();
     else Led9TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Temperatura PCB e Umidade Relativa
-    if(fac_cmd.BoardTemperatureItlkSts || fac_cmd.RelativeHumidityItlkSts) Led10TurnOff();
-    else if(fac_cmd.BoardTemperatureAlarmSts || fac_cmd.RelativeHumidityAlarmSts) Led10Toggle();
+    if(fac_cmd.ItlkSts & (FAC_CMD_BOARD_IIB_OVERTEMP_ITLK | FAC_CMD_BOARD_IIB_OVERHUMIDITY_ITLK)) Led10TurnOff();
+    else if(fac_cmd.AlarmSts & (FAC_CMD_BOARD_IIB_OVERTEMP_ALM | FAC_CMD_BOARD_IIB_OVERHUMIDITY_ALM)) Led10Toggle();
     else Led10TurnOn();
 }
 
@@ -214,152 +175,136 @@ void check_fac_cmd_indication_leds()
 
 void fac_cmd_application_readings()
 {
+    uint32_t alarms = 0;
+
     //PT100 CH1 Indutor
     fac_cmd.TempL.f = Pt100Ch1Read();
-    fac_cmd.TempLAlarmSts = Pt100Ch1AlarmStatusRead();
-    if(!fac_cmd.TempLItlkSts)fac_cmd.TempLItlkSts = Pt100Ch1TripStatusRead();
+    if(Pt100Ch1AlarmStatusRead()) alarms |= FAC_CMD_INDUC_OVERTEMP_ALM;
+    if(Pt100Ch1TripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_INDUC_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //PT100 CH2 Dissipador
     fac_cmd.TempHeatSink.f = Pt100Ch2Read();
-    fac_cmd.TempHeatSinkAlarmSts = Pt100Ch2AlarmStatusRead();
-    if(!fac_cmd.TempHeatSinkItlkSts)fac_cmd.TempHeatSinkItlkSts = Pt100Ch2TripStatusRead();
+    if(Pt100Ch2AlarmStatusRead()) alarms |= FAC_CMD_HS_OVERTEMP_ALM;
+    if(Pt100Ch2TripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_HS_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura PCB IIB
     fac_cmd.BoardTemperature.f = BoardTempRead();
-    fac_cmd.BoardTemperatureAlarmSts = BoardTempAlarmStatusRead();
+    if(BoardTempAlarmStatusRead()) alarms |= FAC_CMD_BOARD_IIB_OVERTEMP_ALM;
 
-#if (ItlkBoardTempEnable == 1)
-
-    if(!fac_cmd.BoardTemperatureItlkSts)fac_cmd.BoardTemperatureItlkSts = BoardTempTripStatusRead();
-
-#endif
+    if(BoardTempTripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_BOARD_IIB_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Umidade Relativa
     fac_cmd.RelativeHumidity.f = RhRead();
-    fac_cmd.RelativeHumidityAlarmSts = RhAlarmStatusRead();
+    if(RhAlarmStatusRead()) alarms |= FAC_CMD_BOARD_IIB_OVERHUMIDITY_ALM;
 
-#if (ItlkRhEnable == 1)
-
-    if(!fac_cmd.RelativeHumidityItlkSts)fac_cmd.RelativeHumidityItlkSts = RhTripStatusRead();
-
-#endif
+    if(RhTripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_BOARD_IIB_OVERHUMIDITY_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Tensao de Saida
     fac_cmd.Vout.f = LvCurrentCh1Read();
-    fac_cmd.VoutAlarmSts = LvCurrentCh1AlarmStatusRead();
-    if(!fac_cmd.VoutItlkSts)fac_cmd.VoutItlkSts = LvCurrentCh1TripStatusRead();
+    if(LvCurrentCh1AlarmStatusRead()) alarms |= FAC_CMD_OUTPUT_OVERVOLTAGE_ALM;
+    if(LvCurrentCh1TripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_OUTPUT_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Tensao no Banco de Capacitores
     fac_cmd.VcapBank.f = LvCurrentCh2Read();
-    fac_cmd.VcapBankAlarmSts = LvCurrentCh2AlarmStatusRead();
-    if(!fac_cmd.VcapBankItlkSts)fac_cmd.VcapBankItlkSts = LvCurrentCh2TripStatusRead();
+    if(LvCurrentCh2AlarmStatusRead()) alarms |= FAC_CMD_CAPBANK_OVERVOLTAGE_ALM;
+    if(LvCurrentCh2TripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_CAPBANK_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Medida de Fuga para o Terra
     fac_cmd.GroundLeakage.f = LvCurrentCh3Read();
-    fac_cmd.GroundLeakageAlarmSts = LvCurrentCh3AlarmStatusRead();
-    if(!fac_cmd.GroundLeakageItlkSts)fac_cmd.GroundLeakageItlkSts = LvCurrentCh3TripStatusRead();
+    if(LvCurrentCh3AlarmStatusRead()) alarms |= FAC_CMD_GROUND_LKG_ALM;
+    if(LvCurrentCh3TripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_GROUND_LKG_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Aux and Idb Voltage
     fac_cmd.AuxIdbVoltage.f = DriverVoltageRead();
-    fac_cmd.AuxIdbVoltageAlarmSts = DriverVoltageAlarmStatusRead();
-    if(!fac_cmd.AuxIdbVoltageItlkSts)fac_cmd.AuxIdbVoltageItlkSts = DriverVolatgeTripStatusRead();
+    if(DriverVoltageAlarmStatusRead()) alarms |= FAC_CMD_AUX_AND_IDB_SUPPLY_OVERVOLTAGE_ALM;
+    if(DriverVolatgeTripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_AUX_AND_IDB_SUPPLY_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Aux Current
     fac_cmd.AuxCurrent.f = Driver1CurrentRead();
-    fac_cmd.AuxCurrentAlarmSts = Driver1CurrentAlarmStatusRead();
-    if(!fac_cmd.AuxCurrentItlkSts)fac_cmd.AuxCurrentItlkSts = Driver1CurrentTripStatusRead();
+    if(Driver1CurrentAlarmStatusRead()) alarms |= FAC_CMD_AUX_SUPPLY_OVERCURRENT_ALM;
+    if(Driver1CurrentTripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_AUX_SUPPLY_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Idb Current
     fac_cmd.IdbCurrent.f = Driver2CurrentRead();
-    fac_cmd.IdbCurrentAlarmSts = Driver2CurrentAlarmStatusRead();
-    if(!fac_cmd.IdbCurrentItlkSts)fac_cmd.IdbCurrentItlkSts = Driver2CurrentTripStatusRead();
+    if(Driver2CurrentAlarmStatusRead()) alarms |= FAC_CMD_IDB_SUPPLY_OVERCURRENT_ALM;
+    if(Driver2CurrentTripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_IDB_SUPPLY_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Main Over Current
     fac_cmd.MainOverCurrentItlk = Gpdi5Read();//Variavel usada para debug
-    if(!fac_cmd.MainOverCurrentItlkSts)fac_cmd.MainOverCurrentItlkSts = Gpdi5Read();
+    if(Gpdi5Read()) fac_cmd.ItlkSts |= FAC_CMD_MAIN_OVER_CURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Emergency Button
     fac_cmd.EmergencyButtonItlk = Gpdi6Read();//Variavel usada para debug
-    if(!fac_cmd.EmergencyButtonItlkSts)fac_cmd.EmergencyButtonItlkSts = Gpdi6Read();
+    if(Gpdi6Read()) fac_cmd.ItlkSts |= FAC_CMD_EMERGENCY_BUTTON_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Main Under Voltage
     fac_cmd.MainUnderVoltageItlk = Gpdi7Read();//Variavel usada para debug
-    if(!fac_cmd.MainUnderVoltageItlkSts)fac_cmd.MainUnderVoltageItlkSts = Gpdi7Read();
+    if(Gpdi7Read()) fac_cmd.ItlkSts |= FAC_CMD_MAIN_UNDER_VOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Main Over Voltage
     fac_cmd.MainOverVoltageItlk = Gpdi8Read();//Variavel usada para debug
-    if(!fac_cmd.MainOverVoltageItlkSts)fac_cmd.MainOverVoltageItlkSts = Gpdi8Read();
+    if(Gpdi8Read()) fac_cmd.ItlkSts |= FAC_CMD_MAIN_OVER_VOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Se nao houver sinal na entrada digital dos 4 sinais, defina a acao como Interlock.
-    if(fac_cmd.MainOverCurrentItlkSts || fac_cmd.EmergencyButtonItlkSts || fac_cmd.MainUnderVoltageItlkSts || fac_cmd.MainOverVoltageItlkSts) InterlockSet();
+    if(fac_cmd.ItlkSts & (FAC_CMD_MAIN_OVER_CURRENT_ITLK | FAC_CMD_EMERGENCY_BUTTON_ITLK | FAC_CMD_MAIN_UNDER_VOLTAGE_ITLK | FAC_CMD_MAIN_OVER_VOLTAGE_ITLK)) InterlockSet();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    if (fac_cmd.VcapBankItlkSts)             itlk_id |= FAC_CMD_CAPBANK_OVERVOLTAGE_ITLK;
-    if (fac_cmd.VoutItlkSts)                 itlk_id |= FAC_CMD_OUTPUT_OVERVOLTAGE_ITLK;
-    if (fac_cmd.AuxIdbVoltageItlkSts)        itlk_id |= FAC_CMD_AUX_AND_IDB_SUPPLY_OVERVOLTAGE_ITLK;
-    if (fac_cmd.AuxCurrentItlkSts)           itlk_id |= FAC_CMD_AUX_SUPPLY_OVERCURRENT_ITLK;
-    if (fac_cmd.IdbCurrentItlkSts)           itlk_id |= FAC_CMD_IDB_SUPPLY_OVERCURRENT_ITLK;
-    if (fac_cmd.TempLItlkSts)                itlk_id |= FAC_CMD_INDUC_OVERTEMP_ITLK;
-    if (fac_cmd.TempHeatSinkItlkSts)         itlk_id |= FAC_CMD_HS_OVERTEMP_ITLK;
-    if (fac_cmd.MainOverCurrentItlkSts)      itlk_id |= FAC_CMD_MAIN_OVER_CURRENT_ITLK;
-    if (fac_cmd.EmergencyButtonItlkSts)      itlk_id |= FAC_CMD_EMERGENCY_BUTTON_ITLK;
-    if (fac_cmd.MainUnderVoltageItlkSts)     itlk_id |= FAC_CMD_MAIN_UNDER_VOLTAGE_ITLK;
-    if (fac_cmd.MainOverVoltageItlkSts)      itlk_id |= FAC_CMD_MAIN_OVER_VOLTAGE_ITLK;
-    if (fac_cmd.GroundLeakageItlkSts)        itlk_id |= FAC_CMD_GROUND_LKG_ITLK;
-    if (fac_cmd.BoardTemperatureItlkSts)     itlk_id |= FAC_CMD_BOARD_IIB_OVERTEMP_ITLK;
-    if (fac_cmd.RelativeHumidityItlkSts)     itlk_id |= FAC_CMD_BOARD_IIB_OVERHUMIDITY_ITLK;
+    //Inclinacao das temperaturas (dT/dt)
+    if(TempSlopeAlarmStatusRead()) alarms |= FAC_CMD_TEMP_SLOPE_ALM;
+    if(TempSlopeTripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_TEMP_SLOPE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    if (fac_cmd.VcapBankAlarmSts)            alarm_id |= FAC_CMD_CAPBANK_OVERVOLTAGE_ALM;
-    if (fac_cmd.VoutItlkSts)                 alarm_id |= FAC_CMD_OUTPUT_OVERVOLTAGE_ALM;
-    if (fac_cmd.AuxIdbVoltageAlarmSts)       alarm_id |= FAC_CMD_AUX_AND_IDB_SUPPLY_OVERVOLTAGE_ALM;
-    if (fac_cmd.AuxCurrentAlarmSts)          alarm_id |= FAC_CMD_AUX_SUPPLY_OVERCURRENT_ALM;
-    if (fac_cmd.IdbCurrentAlarmSts)          alarm_id |= FAC_CMD_IDB_SUPPLY_OVERCURRENT_ALM;
-    if (fac_cmd.TempLAlarmSts)               alarm_id |= FAC_CMD_INDUC_OVERTEMP_ALM;
-    if (fac_cmd.TempHeatSinkAlarmSts)        alarm_id |= FAC_CMD_HS_OVERTEMP_ALM;
-    if (fac_cmd.GroundLeakageAlarmSts)       alarm_id |= FAC_CMD_GROUND_LKG_ALM;
-    if (fac_cmd.BoardTemperatureAlarmSts)    alarm_id |= FAC_CMD_BOARD_IIB_OVERTEMP_ALM;
-    if (fac_cmd.RelativeHumidityAlarmSts)    alarm_id |= FAC_CMD_BOARD_IIB_OVERHUMIDITY_ALM;
+    //Risco de condensacao: ponto de orvalho contra o lado frio
+    fac_cmd.DewPoint.f = DewPointRead();
+    if(DewPointAlarmStatusRead()) alarms |= FAC_CMD_CONDENSATION_ALM;
+    if(DewPointTripStatusRead()) fac_cmd.ItlkSts |= FAC_CMD_CONDENSATION_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    fac_cmd_interlocks_indication = itlk_id;
-    fac_cmd_alarms_indication = alarm_id;
+    //Sensor PT100 falho: nao confiar na ultima leitura mantida
+    if(Pt100Ch1FailureRead() || Pt100Ch2FailureRead() || Pt100Ch3FailureRead() || Pt100Ch4FailureRead()) alarms |= FAC_CMD_PT100_SENSOR_FAIL_ALM;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    fac_cmd.AlarmSts = alarms;
+
+    // Alarmes ficam registrados no quadro ate o proximo clear
+    alarm_id |= fac_cmd.AlarmSts;
 
-    g_controller_iib.iib_itlk[0].u32        = fac_cmd_interlocks_indication;
+    g_controller_iib.iib_itlk[0].u32        = fac_cmd.ItlkSts;
     g_controller_iib.iib_itlk[1].u32        = ResetInterlocksRegister;
 
-    g_controller_iib.iib_alarm[0].u32       = fac_cmd_alarms_indication;
+    g_controller_iib.iib_alarm[0].u32       = alarm_id;
     g_controller_iib.iib_alarm[1].u32       = ResetAlarmsRegister;
 
     g_controller_iib.iib_signals[0].f       = fac_cmd.VcapBank.f;
@@ -372,6 +317,7 @@ void fac_cmd_application_readings()
     g_controller_iib.iib_signals[7].f       = fac_cmd.TempHeatSink.f;
     g_controller_iib.iib_signals[8].f       = fac_cmd.BoardTemperature.f;
     g_controller_iib.iib_signals[9].f       = fac_cmd.RelativeHumidity.f;
+    g_controller_iib.iib_signals[10].f      = fac_cmd.DewPoint.f;
 
 }
 
@@ -412,6 +358,7 @@ void config_module_fac_cmd(void)
 
     //Temperature Board configuration
     BoardTempDelay(Delay_BoardTemp); //Inserir valor de delay
+    BoardTempItlkEnable(ItlkBoardTempEnable);
 
     //Temp board configuration limits
     BoardTempAlarmLevelSet(FAC_CMD_BOARD_OVERTEMP_ALM_LIM);
@@ -421,11 +368,21 @@ void config_module_fac_cmd(void)
 
     //Humidity Board configuration
     RhDelay(Delay_BoardRh); //Inserir valor de delay
+    RhItlkEnable(ItlkRhEnable);
 
     //Rh configuration limits
     RhAlarmLevelSet(FAC_CMD_RH_OVERHUMIDITY_ALM_LIM);
     RhTripLevelSet(FAC_CMD_RH_OVERHUMIDITY_ITLK_LIM);
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Ponto de orvalho contra o PT100 do dissipador (lado da agua)
+#if (Pt100Ch2Enable == ON)
+    DewPointInit(DEW_POINT_PT100_CH2);
+#else
+    DewPointInit(0);
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Configuration Aux and Idb voltage
@@ -458,43 +415,22 @@ void config_module_fac_cmd(void)
 
     //Init Variables
     fac_cmd.VcapBank.f               = 0.0;
-    fac_cmd.VcapBankAlarmSts         = 0;
-    fac_cmd.VcapBankItlkSts          = 0;
     fac_cmd.Vout.f                   = 0.0;
-    fac_cmd.VoutAlarmSts             = 0;
-    fac_cmd.VoutItlkSts              = 0;
     fac_cmd.AuxIdbVoltage.f          = 0.0;
-    fac_cmd.AuxIdbVoltageAlarmSts    = 0;
-    fac_cmd.AuxIdbVoltageItlkSts     = 0;
     fac_cmd.AuxCurrent.f             = 0.0;
-    fac_cmd.AuxCurrentAlarmSts       = 0;
-    fac_cmd.AuxCurrentItlkSts        = 0;
     fac_cmd.IdbCurrent.f             = 0.0;
-    fac_cmd.IdbCurrentAlarmSts       = 0;
-    fac_cmd.IdbCurrentItlkSts        = 0;
     fac_cmd.MainOverCurrentItlk      = 0;
-    fac_cmd.MainOverCurrentItlkSts   = 0;
     fac_cmd.EmergencyButtonItlk      = 0;
-    fac_cmd.EmergencyButtonItlkSts   = 0;
     fac_cmd.MainUnderVoltageItlk     = 0;
-    fac_cmd.MainUnderVoltageItlkSts  = 0;
     fac_cmd.MainOverVoltageItlk      = 0;
-    fac_cmd.MainOverVoltageItlkSts   = 0;
     fac_cmd.GroundLeakage.f          = 0.0;
-    fac_cmd.GroundLeakageAlarmSts    = 0;
-    fac_cmd.GroundLeakageItlkSts     = 0;
     fac_cmd.TempL.f                  = 0.0;
-    fac_cmd.TempLAlarmSts            = 0;
-    fac_cmd.TempLItlkSts             = 0;
     fac_cmd.TempHeatSink.f           = 0.0;
-    fac_cmd.TempHeatSinkAlarmSts     = 0;
-    fac_cmd.TempHeatSinkItlkSts      = 0;
     fac_cmd.BoardTemperature.f       = 0.0;
-    fac_cmd.BoardTemperatureAlarmSts = 0;
-    fac_cmd.BoardTemperatureItlkSts  = 0;
     fac_cmd.RelativeHumidity.f       = 0.0;
-    fac_cmd.RelativeHumidityAlarmSts = 0;
-    fac_cmd.RelativeHumidityItlkSts  = 0;
+    fac_cmd.DewPoint.f               = 0.0;
+    fac_cmd.ItlkSts                  = 0;
+    fac_cmd.AlarmSts                 = 0;
 
 }
 
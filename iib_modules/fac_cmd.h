@@ -29,6 +29,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "application.h"
+#include "telemetry.h"
+#include "capture.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,92 +41,66 @@ typedef struct
         uint8_t     u8[4];
     } VcapBank;
 
-    bool VcapBankAlarmSts;
-    bool VcapBankItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Vout;
 
-    bool VoutAlarmSts;
-    bool VoutItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } AuxIdbVoltage;
 
-    bool AuxIdbVoltageAlarmSts;
-    bool AuxIdbVoltageItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } AuxCurrent;
 
-    bool AuxCurrentAlarmSts;
-    bool AuxCurrentItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } IdbCurrent;
 
-    bool IdbCurrentAlarmSts;
-    bool IdbCurrentItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } TempL;
 
-    bool TempLAlarmSts;
-    bool TempLItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } TempHeatSink;
 
-    bool TempHeatSinkAlarmSts;
-    bool TempHeatSinkItlkSts;
-
     bool MainOverCurrentItlk;
-    bool MainOverCurrentItlkSts;
 
     bool EmergencyButtonItlk;
-    bool EmergencyButtonItlkSts;
 
     bool MainUnderVoltageItlk;
-    bool MainUnderVoltageItlkSts;
 
     bool MainOverVoltageItlk;
-    bool MainOverVoltageItlkSts;
 
     union {
         float       f;
         uint8_t     u8[4];
     } GroundLeakage;
 
-    bool GroundLeakageAlarmSts;
-    bool GroundLeakageItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } BoardTemperature;
 
-    bool BoardTemperatureAlarmSts;
-    bool BoardTemperatureItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } RelativeHumidity;
 
-    bool RelativeHumidityAlarmSts;
-    bool RelativeHumidityItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } DewPoint;
+
+    uint32_t ItlkSts;       // FAC_CMD_*_ITLK, travados ate o clear
+    uint32_t AlarmSts;      // FAC_CMD_*_ALM, estado atual
 
 } fac_cmd_t;
 
@@ -144,6 +120,8 @@ typedef struct
 #define FAC_CMD_GROUND_LKG_ITLK                         0x00000800
 #define FAC_CMD_BOARD_IIB_OVERTEMP_ITLK                 0x00001000
 #define FAC_CMD_BOARD_IIB_OVERHUMIDITY_ITLK             0x00002000
+#define FAC_CMD_TEMP_SLOPE_ITLK                         0x00004000
+#define FAC_CMD_CONDENSATION_ITLK                       0x00008000
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -157,6 +135,22 @@ typedef struct
 #define FAC_CMD_GROUND_LKG_ALM                          0x00000080
 #define FAC_CMD_BOARD_IIB_OVERTEMP_ALM                  0x00000100
 #define FAC_CMD_BOARD_IIB_OVERHUMIDITY_ALM              0x00000200
+#define FAC_CMD_TEMP_SLOPE_ALM                          0x00000400
+#define FAC_CMD_CONDENSATION_ALM                        0x00000800
+#define FAC_CMD_PT100_SENSOR_FAIL_ALM                   0x00001000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quantidade de sinais publicados em iib_signals
+#define FAC_CMD_NUM_SIGNALS                             11
+
+// Canais do ADC interno registrados pela captura pos-interlock
+#define FAC_CMD_CAPTURE_CHANNELS                        (CAPTURE_LV_CURRENT_CH1 | \
+                                                         CAPTURE_LV_CURRENT_CH2 | \
+                                                         CAPTURE_LV_CURRENT_CH3 | \
+                                                         CAPTURE_DRIVER_VOLTAGE | \
+                                                         CAPTURE_DRIVER1_CURRENT | \
+                                                         CAPTURE_DRIVER2_CURRENT)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -169,6 +163,7 @@ extern void fac_cmd_application_readings(void);
 extern void config_module_fac_cmd(void);
 
 extern fac_cmd_t fac_cmd;
+extern const telemetry_signal_cfg_t fac_cmd_telemetry_cfg[FAC_CMD_NUM_SIGNALS];
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
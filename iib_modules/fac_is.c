@@ -30,6 +30,8 @@
 #include "BoardTempHum.h"
 #include "ntc_isolated_i2c.h"
 #include "pt100.h"
+#include "temp_slope.h"
+#include "dew_point.h"
 #include "output.h"
 #include "leds.h"
 #include "can_bus.h"
@@ -49,73 +51,49 @@ fac_is_t fac_is;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t fac_is_interlocks_indication;
-static uint32_t fac_is_alarms_indication;
+// Deadband absoluto, deadband relativo e periodo de envio de cada sinal
+const telemetry_signal_cfg_t fac_is_telemetry_cfg[FAC_IS_NUM_SIGNALS] =
+{
+    { 1.0,  0.01,  1000 },   //  0 VdcLink
+    { 0.5,  0.01,   500 },   //  1 Iin
+    { 0.5,  0.0,   5000 },   //  2 TempIGBT1
+    { 0.1,  0.0,   5000 },   //  3 DriverVoltage
+    { 0.05, 0.0,   5000 },   //  4 Driver1Current
+    { 0.5,  0.0,   5000 },   //  5 TempL
+    { 0.5,  0.0,   5000 },   //  6 TempHeatSink
+    { 0.5,  0.0,  10000 },   //  7 BoardTemperature
+    { 1.0,  0.0,  10000 },   //  8 RelativeHumidity
+    { 0.5,  0.0,  10000 }    //  9 DewPoint
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
 
 static uint32_t ResetInterlocksRegister = 0;
 static uint32_t ResetAlarmsRegister = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t itlk_id;
 static uint32_t alarm_id;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void clear_fac_is_interlocks()
 {
-    fac_is.VdcLinkItlkSts            = 0;
-    fac_is.IinItlkSts                = 0;
-    fac_is.TempIGBT1ItlkSts          = 0;
-    fac_is.TempIGBT1HwrItlkSts       = 0;
-    fac_is.Driver1ErrorTopItlkSts    = 0;
-    fac_is.Driver1ErrorBotItlkSts    = 0;
-    fac_is.TempLItlkSts              = 0;
-    fac_is.TempHeatSinkItlkSts       = 0;
-    fac_is.DriverVoltageItlkSts      = 0;
-    fac_is.Driver1CurrentItlkSts     = 0;
-    fac_is.BoardTemperatureItlkSts   = 0;
-    fac_is.RelativeHumidityItlkSts   = 0;
-
-    itlk_id = 0;
-
+    fac_is.ItlkSts = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 uint8_t check_fac_is_interlocks()
 {
-    uint8_t test = 0;
-
-    test |= fac_is.VdcLinkItlkSts;
-    test |= fac_is.IinItlkSts;
-    test |= fac_is.TempIGBT1ItlkSts;
-    test |= fac_is.TempIGBT1HwrItlkSts;
-    test |= fac_is.Driver1ErrorTopItlkSts;
-    test |= fac_is.Driver1ErrorBotItlkSts;
-    test |= fac_is.TempLItlkSts;
-    test |= fac_is.TempHeatSinkItlkSts;
-    test |= fac_is.DriverVoltageItlkSts;
-    test |= fac_is.Driver1CurrentItlkSts;
-    test |= fac_is.BoardTemperatureItlkSts;
-    test |= fac_is.RelativeHumidityItlkSts;
-
-    return test;
+    return (fac_is.ItlkSts != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void clear_fac_is_alarms()
 {
-    fac_is.VdcLinkAlarmSts           = 0;
-    fac_is.IinAlarmSts               = 0;
-    fac_is.TempIGBT1AlarmSts         = 0;
-    fac_is.TempLAlarmSts             = 0;
-    fac_is.TempHeatSinkAlarmSts      = 0;
-    fac_is.DriverVoltageAlarmSts     = 0;
-    fac_is.Driver1CurrentAlarmSts    = 0;
-    fac_is.BoardTemperatureAlarmSts  = 0;
-    fac_is.RelativeHumidityAlarmSts  = 0;
+    fac_is.AlarmSts = 0;
 
     alarm_id = 0;
 
@@ -125,19 +103,7 @@ void clear_fac_is_alarms()
 
 uint8_t check_fac_is_alarms()
 {
-    uint8_t test = 0;
-
-    test |= fac_is.VdcLinkAlarmSts;
-    test |= fac_is.IinAlarmSts;
-    test |= fac_is.TempIGBT1AlarmSts;
-    test |= fac_is.TempLAlarmSts;
-    test |= fac_is.TempHeatSinkAlarmSts;
-    test |= fac_is.DriverVoltageAlarmSts;
-    test |= fac_is.Driver1CurrentAlarmSts;
-    test |= fac_is.BoardTemperatureAlarmSts;
-    test |= fac_is.RelativeHumidityAlarmSts;
-
-    return test;
+    return (fac_is.AlarmSts != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -145,63 +111,63 @@ uint8_t check_fac_is_alarms()
 void check_fac_is_indication_leds()
 {
     // Dc-Link Overvoltage
-    if(fac_is.VdcLinkItlkSts) Led2TurnOff();
-    else if(fac_is.VdcLinkAlarmSts) Led2Toggle();
+    if(fac_is.ItlkSts & FAC_IS_DCLINK_OVERVOLTAGE_ITLK) Led2TurnOff();
+    else if(fac_is.AlarmSts & FAC_IS_DCLINK_OVERVOLTAGE_ALM) Led2Toggle();
     else Led2TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Input Over Current
-    if(fac_is.IinItlkSts) Led3TurnOff();
-    else if(fac_is.IinAlarmSts) Led3Toggle();
+    if(fac_is.ItlkSts & FAC_IS_INPUT_OVERCURRENT_ITLK) Led3TurnOff();
+    else if(fac_is.AlarmSts & FAC_IS_INPUT_OVERCURRENT_ALM) Led3Toggle();
     else Led3TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks do Driver 1
-    if(fac_is.Driver1ErrorTopItlkSts || fac_is.Driver1ErrorBotItlkSts) Led4TurnOff();
+    if(fac_is.ItlkSts & (FAC_IS_DRIVER1_ERROR_TOP_ITLK | FAC_IS_DRIVER1_ERROR_BOT_ITLK)) Led4TurnOff();
     else Led4TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Heatsink Over Temperature
-    if(fac_is.TempHeatSinkItlkSts) Led5TurnOff();
-    else if(fac_is.TempHeatSinkAlarmSts) Led5Toggle();
+    if(fac_is.ItlkSts & FAC_IS_HS_OVERTEMP_ITLK) Led5TurnOff();
+    else if(fac_is.AlarmSts & FAC_IS_HS_OVERTEMP_ALM) Led5Toggle();
     else Led5TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Inductor Over Temperature
-    if(fac_is.TempLItlkSts) Led6TurnOff();
-    else if(fac_is.TempLAlarmSts) Led6Toggle();
+    if(fac_is.ItlkSts & FAC_IS_INDUC_OVERTEMP_ITLK) Led6TurnOff();
+    else if(fac_is.AlarmSts & FAC_IS_INDUC_OVERTEMP_ALM) Led6Toggle();
     else Led6TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Over temperature igbt1
-    if(fac_is.TempIGBT1ItlkSts || fac_is.TempIGBT1HwrItlkSts) Led7TurnOff();
-    else if(fac_is.TempIGBT1AlarmSts) Led7Toggle();
+    if(fac_is.ItlkSts & (FAC_IS_IGBT1_OVERTEMP_ITLK | FAC_IS_IGBT1_HWR_OVERTEMP_ITLK)) Led7TurnOff();
+    else if(fac_is.AlarmSts & FAC_IS_IGBT1_OVERTEMP_ALM) Led7Toggle();
     else Led7TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks do Driver
-    if(fac_is.DriverVoltageItlkSts || fac_is.Driver1CurrentItlkSts) Led8TurnOff();
-    else if(fac_is.DriverVoltageAlarmSts || fac_is.Driver1CurrentAlarmSts) Led8Toggle();
+    if(fac_is.ItlkSts & (FAC_IS_DRIVER_OVERVOLTAGE_ITLK | FAC_IS_DRIVER1_OVERCURRENT_ITLK)) Led8TurnOff();
+    else if(fac_is.AlarmSts & (FAC_IS_DRIVER_OVERVOLTAGE_ALM | FAC_IS_DRIVER1_OVERCURRENT_ALM)) Led8Toggle();
     else Led8TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Temperatura PCB
-    if(fac_is.BoardTemperatureItlkSts) Led9TurnOff();
-    else if(fac_is.BoardTemperatureAlarmSts) Led9Toggle();
+    if(fac_is.ItlkSts & FAC_IS_BOARD_IIB_OVERTEMP_ITLK) Led9TurnOff();
+    else if(fac_is.AlarmSts & FAC_IS_BOARD_IIB_OVERTEMP_ALM) Led9Toggle();
     else Led9TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Umidade Relativa
-    if(fac_is.RelativeHumidityItlkSts) Led10TurnOff();
-    else if(fac_is.RelativeHumidityAlarmSts) Led10Toggle();
+    if(fac_is.ItlkSts & FAC_IS_BOARD_IIB_OVERHUMIDITY_ITLK) Led10TurnOff();
+    else if(fac_is.AlarmSts & FAC_IS_BOARD_IIB_OVERHUMIDITY_ALM) Led10Toggle();
     else Led10TurnOn();
 }
 
@@ -209,134 +175,121 @@ void check_fac_is_indication_leds()
 
 void fac_is_application_readings()
 {
+    uint32_t alarms = 0;
+
     //PT100 CH1 Dissipador
     fac_is.TempHeatSink.f = Pt100Ch1Read();
-    fac_is.TempHeatSinkAlarmSts = Pt100Ch1AlarmStatusRead();
-    if(!fac_is.TempHeatSinkItlkSts)fac_is.TempHeatSinkItlkSts = Pt100Ch1TripStatusRead();
+    if(Pt100Ch1AlarmStatusRead()) alarms |= FAC_IS_HS_OVERTEMP_ALM;
+    if(Pt100Ch1TripStatusRead()) fac_is.ItlkSts |= FAC_IS_HS_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //PT100 CH2 Indutor
     fac_is.TempL.f = Pt100Ch2Read();
-    fac_is.TempLAlarmSts = Pt100Ch2AlarmStatusRead();
-    if(!fac_is.TempLItlkSts)fac_is.TempLItlkSts = Pt100Ch2TripStatusRead();
+    if(Pt100Ch2AlarmStatusRead()) alarms |= FAC_IS_INDUC_OVERTEMP_ALM;
+    if(Pt100Ch2TripStatusRead()) fac_is.ItlkSts |= FAC_IS_INDUC_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT1
     fac_is.TempIGBT1.f = TempIgbt1Read();
-    fac_is.TempIGBT1AlarmSts = TempIgbt1AlarmStatusRead();
-    if(!fac_is.TempIGBT1ItlkSts)fac_is.TempIGBT1ItlkSts = TempIgbt1TripStatusRead();
+    if(TempIgbt1AlarmStatusRead()) alarms |= FAC_IS_IGBT1_OVERTEMP_ALM;
+    if(TempIgbt1TripStatusRead()) fac_is.ItlkSts |= FAC_IS_IGBT1_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT1 Hardware
     fac_is.TempIGBT1HwrItlk = Driver1OverTempRead();//Variavel usada para debug
-    if(!fac_is.TempIGBT1HwrItlkSts)fac_is.TempIGBT1HwrItlkSts = Driver1OverTempRead();
+    if(Driver1OverTempRead()) fac_is.ItlkSts |= FAC_IS_IGBT1_HWR_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura PCB IIB
     fac_is.BoardTemperature.f = BoardTempRead();
-    fac_is.BoardTemperatureAlarmSts = BoardTempAlarmStatusRead();
+    if(BoardTempAlarmStatusRead()) alarms |= FAC_IS_BOARD_IIB_OVERTEMP_ALM;
 
-#if (ItlkBoardTempEnable == 1)
-
-    if(!fac_is.BoardTemperatureItlkSts)fac_is.BoardTemperatureItlkSts = BoardTempTripStatusRead();
-
-#endif
+    if(BoardTempTripStatusRead()) fac_is.ItlkSts |= FAC_IS_BOARD_IIB_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Umidade Relativa
     fac_is.RelativeHumidity.f = RhRead();
-    fac_is.RelativeHumidityAlarmSts = RhAlarmStatusRead();
+    if(RhAlarmStatusRead()) alarms |= FAC_IS_BOARD_IIB_OVERHUMIDITY_ALM;
 
-#if (ItlkRhEnable == 1)
-
-    if(!fac_is.RelativeHumidityItlkSts)fac_is.RelativeHumidityItlkSts = RhTripStatusRead();
-
-#endif
+    if(RhTripStatusRead()) fac_is.ItlkSts |= FAC_IS_BOARD_IIB_OVERHUMIDITY_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //DriverVotage
     fac_is.DriverVoltage.f = DriverVoltageRead();
-    fac_is.DriverVoltageAlarmSts = DriverVoltageAlarmStatusRead();
-    if(!fac_is.DriverVoltageItlkSts)fac_is.DriverVoltageItlkSts = DriverVolatgeTripStatusRead();
+    if(DriverVoltageAlarmStatusRead()) alarms |= FAC_IS_DRIVER_OVERVOLTAGE_ALM;
+    if(DriverVolatgeTripStatusRead()) fac_is.ItlkSts |= FAC_IS_DRIVER_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Drive1Current
     fac_is.Driver1Current.f = Driver1CurrentRead();
-    fac_is.Driver1CurrentAlarmSts = Driver1CurrentAlarmStatusRead();
-    if(!fac_is.Driver1CurrentItlkSts)fac_is.Driver1CurrentItlkSts = Driver1CurrentTripStatusRead();
+    if(Driver1CurrentAlarmStatusRead()) alarms |= FAC_IS_DRIVER1_OVERCURRENT_ALM;
+    if(Driver1CurrentTripStatusRead()) fac_is.ItlkSts |= FAC_IS_DRIVER1_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     fac_is.VdcLink.f = LvCurrentCh1Read();
-    fac_is.VdcLinkAlarmSts = LvCurrentCh1AlarmStatusRead();
-    if(!fac_is.VdcLinkItlkSts)fac_is.VdcLinkItlkSts = LvCurrentCh1TripStatusRead();
+    if(LvCurrentCh1AlarmStatusRead()) alarms |= FAC_IS_DCLINK_OVERVOLTAGE_ALM;
+    if(LvCurrentCh1TripStatusRead()) fac_is.ItlkSts |= FAC_IS_DCLINK_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     fac_is.Iin.f = CurrentCh1Read();
-    fac_is.IinAlarmSts = CurrentCh1AlarmStatusRead();
-    if(!fac_is.IinItlkSts)fac_is.IinItlkSts = CurrentCh1TripStatusRead();
+    if(CurrentCh1AlarmStatusRead()) alarms |= FAC_IS_INPUT_OVERCURRENT_ALM;
+    if(CurrentCh1TripStatusRead()) fac_is.ItlkSts |= FAC_IS_INPUT_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Erro do Driver 1 Top
     fac_is.Driver1ErrorTop = Driver1TopErrorRead();//Variavel usada para debug
-    if(!fac_is.Driver1ErrorTopItlkSts)fac_is.Driver1ErrorTopItlkSts = Driver1TopErrorRead();
+    if(Driver1TopErrorRead()) fac_is.ItlkSts |= FAC_IS_DRIVER1_ERROR_TOP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Erro do Driver 1 Bot
     fac_is.Driver1ErrorBot = Driver1BotErrorRead();//Variavel usada para debug
-    if(!fac_is.Driver1ErrorBotItlkSts)fac_is.Driver1ErrorBotItlkSts = Driver1BotErrorRead();
+    if(Driver1BotErrorRead()) fac_is.ItlkSts |= FAC_IS_DRIVER1_ERROR_BOT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Se nao houver sinal na entrada digital dos 3 sinais, defina a acao como Interlock.
-    if(fac_is.Driver1ErrorTopItlkSts || fac_is.Driver1ErrorBotItlkSts || fac_is.TempIGBT1HwrItlkSts) InterlockSet();
+    if(fac_is.ItlkSts & (FAC_IS_DRIVER1_ERROR_TOP_ITLK | FAC_IS_DRIVER1_ERROR_BOT_ITLK | FAC_IS_IGBT1_HWR_OVERTEMP_ITLK)) InterlockSet();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    if (fac_is.VdcLinkItlkSts)              itlk_id |= FAC_IS_DCLINK_OVERVOLTAGE_ITLK;
-    if (fac_is.IinItlkSts)                  itlk_id |= FAC_IS_INPUT_OVERCURRENT_ITLK;
-    if (fac_is.TempIGBT1ItlkSts)            itlk_id |= FAC_IS_IGBT1_OVERTEMP_ITLK;
-    if (fac_is.TempIGBT1HwrItlkSts)         itlk_id |= FAC_IS_IGBT1_HWR_OVERTEMP_ITLK;
-    if (fac_is.DriverVoltageItlkSts)        itlk_id |= FAC_IS_DRIVER_OVERVOLTAGE_ITLK;
-    if (fac_is.Driver1CurrentItlkSts)       itlk_id |= FAC_IS_DRIVER1_OVERCURRENT_ITLK;
-    if (fac_is.Driver1ErrorTopItlkSts)      itlk_id |= FAC_IS_DRIVER1_ERROR_TOP_ITLK;
-    if (fac_is.Driver1ErrorBotItlkSts)      itlk_id |= FAC_IS_DRIVER1_ERROR_BOT_ITLK;
-    if (fac_is.TempLItlkSts)                itlk_id |= FAC_IS_INDUC_OVERTEMP_ITLK;
-    if (fac_is.TempHeatSinkItlkSts)         itlk_id |= FAC_IS_HS_OVERTEMP_ITLK;
-    if (fac_is.BoardTemperatureItlkSts)     itlk_id |= FAC_IS_BOARD_IIB_OVERTEMP_ITLK;
-    if (fac_is.RelativeHumidityItlkSts)     itlk_id |= FAC_IS_BOARD_IIB_OVERHUMIDITY_ITLK;
+    //Inclinacao das temperaturas (dT/dt)
+    if(TempSlopeAlarmStatusRead()) alarms |= FAC_IS_TEMP_SLOPE_ALM;
+    if(TempSlopeTripStatusRead()) fac_is.ItlkSts |= FAC_IS_TEMP_SLOPE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    if (fac_is.VdcLinkAlarmSts)             alarm_id |= FAC_IS_DCLINK_OVERVOLTAGE_ALM;
-    if (fac_is.IinAlarmSts)                 alarm_id |= FAC_IS_INPUT_OVERCURRENT_ALM;
-    if (fac_is.TempIGBT1AlarmSts)           alarm_id |= FAC_IS_IGBT1_OVERTEMP_ALM;
-    if (fac_is.DriverVoltageAlarmSts)       alarm_id |= FAC_IS_DRIVER_OVERVOLTAGE_ALM;
-    if (fac_is.Driver1CurrentAlarmSts)      alarm_id |= FAC_IS_DRIVER1_OVERCURRENT_ALM;
-    if (fac_is.TempLAlarmSts)               alarm_id |= FAC_IS_INDUC_OVERTEMP_ALM;
-    if (fac_is.TempHeatSinkAlarmSts)        alarm_id |= FAC_IS_HS_OVERTEMP_ALM;
-    if (fac_is.BoardTemperatureAlarmSts)    alarm_id |= FAC_IS_BOARD_IIB_OVERTEMP_ALM;
-    if (fac_is.RelativeHumidityAlarmSts)    alarm_id |= FAC_IS_BOARD_IIB_OVERHUMIDITY_ALM;
+    //Risco de condensacao: ponto de orvalho contra o lado frio
+    fac_is.DewPoint.f = DewPointRead();
+    if(DewPointAlarmStatusRead()) alarms |= FAC_IS_CONDENSATION_ALM;
+    if(DewPointTripStatusRead()) fac_is.ItlkSts |= FAC_IS_CONDENSATION_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    fac_is_interlocks_indication = itlk_id;
-    fac_is_alarms_indication = alarm_id;
+    //Sensor PT100 falho: nao confiar na ultima leitura mantida
+    if(Pt100Ch1FailureRead() || Pt100Ch2FailureRead() || Pt100Ch3FailureRead() || Pt100Ch4FailureRead()) alarms |= FAC_IS_PT100_SENSOR_FAIL_ALM;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    fac_is.AlarmSts = alarms;
+
+    // Alarmes ficam registrados no quadro ate o proximo clear
+    alarm_id |= fac_is.AlarmSts;
 
-    g_controller_iib.iib_itlk[0].u32        = fac_is_interlocks_indication;
+    g_controller_iib.iib_itlk[0].u32        = fac_is.ItlkSts;
     g_controller_iib.iib_itlk[1].u32        = ResetInterlocksRegister;
 
-    g_controller_iib.iib_alarm[0].u32       = fac_is_alarms_indication;
+    g_controller_iib.iib_alarm[0].u32       = alarm_id;
     g_controller_iib.iib_alarm[1].u32       = ResetAlarmsRegister;
 
     g_controller_iib.iib_signals[0].f       = fac_is.VdcLink.f;
@@ -348,6 +301,7 @@ void fac_is_application_readings()
     g_controller_iib.iib_signals[6].f       = fac_is.TempHeatSink.f;
     g_controller_iib.iib_signals[7].f       = fac_is.BoardTemperature.f;
     g_controller_iib.iib_signals[8].f       = fac_is.RelativeHumidity.f;
+    g_controller_iib.iib_signals[9].f       = fac_is.DewPoint.f;
 
 }
 
@@ -400,6 +354,7 @@ void config_module_fac_is(void)
 
     //Temperature Board configuration
     BoardTempDelay(Delay_BoardTemp); //Inserir valor de delay
+    BoardTempItlkEnable(ItlkBoardTempEnable);
 
     //Temp board configuration limits
     BoardTempAlarmLevelSet(FAC_IS_BOARD_OVERTEMP_ALM_LIM);
@@ -409,11 +364,21 @@ void config_module_fac_is(void)
 
     //Humidity Board configuration
     RhDelay(Delay_BoardRh); //Inserir valor de delay
+    RhItlkEnable(ItlkRhEnable);
 
     //Rh configuration limits
     RhAlarmLevelSet(FAC_IS_RH_OVERHUMIDITY_ALM_LIM);
     RhTripLevelSet(FAC_IS_RH_OVERHUMIDITY_ITLK_LIM);
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Ponto de orvalho contra o PT100 do dissipador (lado da agua)
+#if (Pt100Ch1Enable == ON)
+    DewPointInit(DEW_POINT_PT100_CH1);
+#else
+    DewPointInit(0);
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Driver Voltage configuration
@@ -442,38 +407,20 @@ void config_module_fac_is(void)
 
     // Init Variables
     fac_is.Iin.f                      = 0.0;
-    fac_is.IinAlarmSts                = 0;
-    fac_is.IinItlkSts                 = 0;
     fac_is.VdcLink.f                  = 0.0;
-    fac_is.VdcLinkAlarmSts            = 0;
-    fac_is.VdcLinkItlkSts             = 0;
     fac_is.TempIGBT1.f                = 0.0;
-    fac_is.TempIGBT1AlarmSts          = 0;
-    fac_is.TempIGBT1ItlkSts           = 0;
     fac_is.TempIGBT1HwrItlk           = 0;
-    fac_is.TempIGBT1HwrItlkSts        = 0;
     fac_is.DriverVoltage.f            = 0.0;
-    fac_is.DriverVoltageAlarmSts      = 0;
-    fac_is.DriverVoltageItlkSts       = 0;
     fac_is.Driver1Current.f           = 0.0;
-    fac_is.Driver1CurrentAlarmSts     = 0;
-    fac_is.Driver1CurrentItlkSts      = 0;
     fac_is.Driver1ErrorTop            = 0;
-    fac_is.Driver1ErrorTopItlkSts     = 0;
     fac_is.Driver1ErrorBot            = 0;
-    fac_is.Driver1ErrorBotItlkSts     = 0;
     fac_is.TempL.f                    = 0.0;
-    fac_is.TempLAlarmSts              = 0;
-    fac_is.TempLItlkSts               = 0;
     fac_is.TempHeatSink.f             = 0.0;
-    fac_is.TempHeatSinkAlarmSts       = 0;
-    fac_is.TempHeatSinkItlkSts        = 0;
     fac_is.BoardTemperature.f         = 0.0;
-    fac_is.BoardTemperatureAlarmSts   = 0;
-    fac_is.BoardTemperatureItlkSts    = 0;
     fac_is.RelativeHumidity.f         = 0.0;
-    fac_is.RelativeHumidityAlarmSts   = 0;
-    fac_is.RelativeHumidityItlkSts    = 0;
+    fac_is.DewPoint.f                 = 0.0;
+    fac_is.ItlkSts                    = 0;
+    fac_is.AlarmSts                   = 0;
 
 }
 
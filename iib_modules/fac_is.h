@@ -29,6 +29,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "application.h"
+#include "telemetry.h"
+#include "capture.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,80 +41,58 @@ typedef struct
         uint8_t     u8[4];
     } Iin;
 
-    bool IinAlarmSts;
-    bool IinItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } VdcLink;
 
-    bool VdcLinkAlarmSts;
-    bool VdcLinkItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } TempIGBT1;
-
-    bool TempIGBT1AlarmSts;
-    bool TempIGBT1ItlkSts;
     bool TempIGBT1HwrItlk;
-    bool TempIGBT1HwrItlkSts;
 
     union {
         float       f;
         uint8_t     u8[4];
     } DriverVoltage;
 
-    bool DriverVoltageAlarmSts;
-    bool DriverVoltageItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Driver1Current;
 
-    bool Driver1CurrentAlarmSts;
-    bool Driver1CurrentItlkSts;
-
     bool Driver1ErrorTop;
-    bool Driver1ErrorTopItlkSts;
 
     bool Driver1ErrorBot;
-    bool Driver1ErrorBotItlkSts;
 
     union {
         float       f;
         uint8_t     u8[4];
     } TempL;
 
-    bool TempLAlarmSts;
-    bool TempLItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } TempHeatSink;
 
-    bool TempHeatSinkAlarmSts;
-    bool TempHeatSinkItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } BoardTemperature;
 
-    bool BoardTemperatureAlarmSts;
-    bool BoardTemperatureItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } RelativeHumidity;
 
-    bool RelativeHumidityAlarmSts;
-    bool RelativeHumidityItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } DewPoint;
+
+    uint32_t ItlkSts;       // FAC_IS_*_ITLK, travados ate o clear
+    uint32_t AlarmSts;      // FAC_IS_*_ALM, estado atual
 
 } fac_is_t;
 
@@ -130,6 +110,8 @@ typedef struct
 #define FAC_IS_HS_OVERTEMP_ITLK                0x00000200
 #define FAC_IS_BOARD_IIB_OVERTEMP_ITLK         0x00000400
 #define FAC_IS_BOARD_IIB_OVERHUMIDITY_ITLK     0x00000800
+#define FAC_IS_TEMP_SLOPE_ITLK                 0x00001000
+#define FAC_IS_CONDENSATION_ITLK               0x00002000
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -142,6 +124,20 @@ typedef struct
 #define FAC_IS_HS_OVERTEMP_ALM                 0x00000040
 #define FAC_IS_BOARD_IIB_OVERTEMP_ALM          0x00000080
 #define FAC_IS_BOARD_IIB_OVERHUMIDITY_ALM      0x00000100
+#define FAC_IS_TEMP_SLOPE_ALM                  0x00000200
+#define FAC_IS_CONDENSATION_ALM                0x00000400
+#define FAC_IS_PT100_SENSOR_FAIL_ALM           0x00000800
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quantidade de sinais publicados em iib_signals
+#define FAC_IS_NUM_SIGNALS                     10
+
+// Canais do ADC interno registrados pela captura pos-interlock
+#define FAC_IS_CAPTURE_CHANNELS                (CAPTURE_CURRENT_CH1 | \
+                                                CAPTURE_LV_CURRENT_CH1 | \
+                                                CAPTURE_DRIVER_VOLTAGE | \
+                                                CAPTURE_DRIVER1_CURRENT)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -154,6 +150,7 @@ extern void fac_is_application_readings(void);
 extern void config_module_fac_is(void);
 
 extern fac_is_t fac_is;
+extern const telemetry_signal_cfg_t fac_is_telemetry_cfg[FAC_IS_NUM_SIGNALS];
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
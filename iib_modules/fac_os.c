@@ -30,6 +30,8 @@
 #include "BoardTempHum.h"
 #include "ntc_isolated_i2c.h"
 #include "pt100.h"
+#include "temp_slope.h"
+#include "dew_point.h"
 #include "output.h"
 #include "leds.h"
 #include "can_bus.h"
@@ -49,91 +51,57 @@ fac_os_t fac_os;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t fac_os_interlocks_indication;
-static uint32_t fac_os_alarms_indication;
+// Deadband absoluto, deadband relativo e periodo de envio de cada sinal
+const telemetry_signal_cfg_t fac_os_telemetry_cfg[FAC_OS_NUM_SIGNALS] =
+{
+    { 1.0,  0.01,  1000 },   //  0 VdcLink
+    { 0.5,  0.01,   500 },   //  1 Iin
+    { 0.5,  0.01,   500 },   //  2 Iout
+    { 0.5,  0.0,   5000 },   //  3 TempIGBT1
+    { 0.5,  0.0,   5000 },   //  4 TempIGBT2
+    { 0.1,  0.0,   5000 },   //  5 DriverVoltage
+    { 0.05, 0.0,   5000 },   //  6 Driver1Current
+    { 0.05, 0.0,   5000 },   //  7 Driver2Current
+    { 0.5,  0.01,  1000 },   //  8 GroundLeakage
+    { 0.5,  0.0,   5000 },   //  9 TempL
+    { 0.5,  0.0,   5000 },   // 10 TempHeatSink
+    { 0.5,  0.0,  10000 },   // 11 BoardTemperature
+    { 1.0,  0.0,  10000 },   // 12 RelativeHumidity
+    { 0.5,  0.01,  2000 },   // 13 IinRms
+    { 0.5,  0.01,  2000 },   // 14 IinRipple
+    { 1.0,  0.01,  2000 },   // 15 VdcLinkRms
+    { 0.5,  0.01,  2000 },   // 16 VdcLinkRipple
+    { 0.5,  0.0,  10000 }    // 17 DewPoint
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
 
 static uint32_t ResetInterlocksRegister = 0;
 static uint32_t ResetAlarmsRegister = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t itlk_id;
 static uint32_t alarm_id;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void clear_fac_os_interlocks()
 {
-    fac_os.VdcLinkItlkSts           = 0;
-    fac_os.IinItlkSts               = 0;
-    fac_os.IoutItlkSts              = 0;
-    fac_os.TempIGBT1ItlkSts         = 0;
-    fac_os.TempIGBT1HwrItlkSts      = 0;
-    fac_os.TempIGBT2ItlkSts         = 0;
-    fac_os.TempIGBT2HwrItlkSts      = 0;
-    fac_os.Driver1ErrorTopItlkSts   = 0;
-    fac_os.Driver1ErrorBotItlkSts   = 0;
-    fac_os.Driver2ErrorTopItlkSts   = 0;
-    fac_os.Driver2ErrorBotItlkSts   = 0;
-    fac_os.GroundLeakageItlkSts     = 0;
-    fac_os.TempLItlkSts             = 0;
-    fac_os.TempHeatSinkItlkSts      = 0;
-    fac_os.DriverVoltageItlkSts     = 0;
-    fac_os.Driver1CurrentItlkSts    = 0;
-    fac_os.Driver2CurrentItlkSts    = 0;
-    fac_os.BoardTemperatureItlkSts  = 0;
-    fac_os.RelativeHumidityItlkSts  = 0;
-
-    itlk_id = 0;
-
+    fac_os.ItlkSts = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 uint8_t check_fac_os_interlocks()
 {
-    uint8_t test = 0;
-
-    test |= fac_os.VdcLinkItlkSts;
-    test |= fac_os.IinItlkSts;
-    test |= fac_os.IoutItlkSts;
-    test |= fac_os.TempIGBT1ItlkSts;
-    test |= fac_os.TempIGBT1HwrItlkSts;
-    test |= fac_os.TempIGBT2ItlkSts;
-    test |= fac_os.TempIGBT2HwrItlkSts;
-    test |= fac_os.Driver1ErrorTopItlkSts;
-    test |= fac_os.Driver1ErrorBotItlkSts;
-    test |= fac_os.Driver2ErrorTopItlkSts;
-    test |= fac_os.Driver2ErrorBotItlkSts;
-    test |= fac_os.GroundLeakageItlkSts;
-    test |= fac_os.TempLItlkSts;
-    test |= fac_os.TempHeatSinkItlkSts;
-    test |= fac_os.DriverVoltageItlkSts;
-    test |= fac_os.Driver1CurrentItlkSts;
-    test |= fac_os.Driver2CurrentItlkSts;
-    test |= fac_os.BoardTemperatureItlkSts;
-    test |= fac_os.RelativeHumidityItlkSts;
-
-    return test;
+    return (fac_os.ItlkSts != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void clear_fac_os_alarms()
 {
-    fac_os.VdcLinkAlarmSts           = 0;
-    fac_os.IinAlarmSts               = 0;
-    fac_os.IoutAlarmSts              = 0;
-    fac_os.TempIGBT1AlarmSts         = 0;
-    fac_os.TempIGBT2AlarmSts         = 0;
-    fac_os.GroundLeakageAlarmSts     = 0;
-    fac_os.TempLAlarmSts             = 0;
-    fac_os.TempHeatSinkAlarmSts      = 0;
-    fac_os.DriverVoltageAlarmSts     = 0;
-    fac_os.Driver1CurrentAlarmSts    = 0;
-    fac_os.Driver2CurrentAlarmSts    = 0;
-    fac_os.BoardTemperatureAlarmSts  = 0;
-    fac_os.RelativeHumidityAlarmSts  = 0;
+    fac_os.AlarmSts = 0;
 
     alarm_id = 0;
 
@@ -143,23 +111,7 @@ void clear_fac_os_alarms()
 
 uint8_t check_fac_os_alarms()
 {
-    uint8_t test = 0;
-
-    test |= fac_os.VdcLinkAlarmSts;
-    test |= fac_os.IinAlarmSts;
-    test |= fac_os.IoutAlarmSts;
-    test |= fac_os.TempIGBT1AlarmSts;
-    test |= fac_os.TempIGBT2AlarmSts;
-    test |= fac_os.GroundLeakageAlarmSts;
-    test |= fac_os.TempLAlarmSts;
-    test |= fac_os.TempHeatSinkAlarmSts;
-    test |= fac_os.DriverVoltageAlarmSts;
-    test |= fac_os.Driver1CurrentAlarmSts;
-    test |= fac_os.Driver2CurrentAlarmSts;
-    test |= fac_os.BoardTemperatureAlarmSts;
-    test |= fac_os.RelativeHumidityAlarmSts;
-
-    return test;
+    return (fac_os.AlarmSts != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -167,63 +119,63 @@ uint8_t check_fac_os_alarms()
 void check_fac_os_indication_leds()
 {
     //Input over voltage
-    if(fac_os.VdcLinkItlkSts) Led2TurnOff();
-    else if(fac_os.VdcLinkAlarmSts) Led2Toggle();
+    if(fac_os.ItlkSts & FAC_OS_INPUT_OVERVOLTAGE_ITLK) Led2TurnOff();
+    else if(fac_os.AlarmSts & FAC_OS_INPUT_OVERVOLTAGE_ALM) Led2Toggle();
     else Led2TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Input over current
-    if(fac_os.IinItlkSts) Led3TurnOff();
-    else if(fac_os.IinAlarmSts) Led3Toggle();
+    if(fac_os.ItlkSts & FAC_OS_INPUT_OVERCURRENT_ITLK) Led3TurnOff();
+    else if(fac_os.AlarmSts & FAC_OS_INPUT_OVERCURRENT_ALM) Led3Toggle();
     else Led3TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Output over current
-    if(fac_os.IoutItlkSts) Led4TurnOff();
-    else if(fac_os.IoutAlarmSts) Led4Toggle();
+    if(fac_os.ItlkSts & FAC_OS_OUTPUT_OVERCURRENT_ITLK) Led4TurnOff();
+    else if(fac_os.AlarmSts & FAC_OS_OUTPUT_OVERCURRENT_ALM) Led4Toggle();
     else Led4TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks dos Drivers
-    if(fac_os.Driver1ErrorTopItlkSts || fac_os.Driver1ErrorBotItlkSts || fac_os.Driver2ErrorTopItlkSts || fac_os.Driver2ErrorBotItlkSts) Led5TurnOff();
+    if(fac_os.ItlkSts & (FAC_OS_DRIVER1_ERROR_TOP_ITLK | FAC_OS_DRIVER1_ERROR_BOT_ITLK | FAC_OS_DRIVER2_ERROR_TOP_ITLK | FAC_OS_DRIVER2_ERROR_BOT_ITLK)) Led5TurnOff();
     else Led5TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Heatsink and Inductor Over temperature
-    if(fac_os.TempHeatSinkItlkSts || fac_os.TempLItlkSts) Led6TurnOff();
-    else if(fac_os.TempHeatSinkAlarmSts || fac_os.TempLAlarmSts) Led6Toggle();
+    if(fac_os.ItlkSts & (FAC_OS_HS_OVERTEMP_ITLK | FAC_OS_INDUC_OVERTEMP_ITLK)) Led6TurnOff();
+    else if(fac_os.AlarmSts & (FAC_OS_HS_OVERTEMP_ALM | FAC_OS_INDUC_OVERTEMP_ALM)) Led6Toggle();
     else Led6TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Fuga para o Terra
-    if(fac_os.GroundLeakageItlkSts) Led7TurnOff();
-    else if(fac_os.GroundLeakageAlarmSts) Led7Toggle();
+    if(fac_os.ItlkSts & FAC_OS_GROUND_LKG_ITLK) Led7TurnOff();
+    else if(fac_os.AlarmSts & FAC_OS_GROUND_LKG_ALM) Led7Toggle();
     else Led7TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Over temperature igbt1 and igbt2
-    if(fac_os.TempIGBT1ItlkSts || fac_os.TempIGBT1HwrItlkSts || fac_os.TempIGBT2ItlkSts || fac_os.TempIGBT2HwrItlkSts) Led8TurnOff();
-    else if(fac_os.TempIGBT1AlarmSts || fac_os.TempIGBT2AlarmSts) Led8Toggle();
+    if(fac_os.ItlkSts & (FAC_OS_IGBT1_OVERTEMP_ITLK | FAC_OS_IGBT1_HWR_OVERTEMP_ITLK | FAC_OS_IGBT2_OVERTEMP_ITLK | FAC_OS_IGBT2_HWR_OVERTEMP_ITLK)) Led8TurnOff();
+    else if(fac_os.AlarmSts & (FAC_OS_IGBT1_OVERTEMP_ALM | FAC_OS_IGBT2_OVERTEMP_ALM)) Led8Toggle();
     else Led8TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks dos Drivers
-    if(fac_os.DriverVoltageItlkSts || fac_os.Driver1CurrentItlkSts || fac_os.Driver2CurrentItlkSts) Led9TurnOff();
-    else if(fac_os.DriverVoltageAlarmSts || fac_os.Driver1CurrentAlarmSts || fac_os.Driver2CurrentAlarmSts) Led9Toggle();
+    if(fac_os.ItlkSts & (FAC_OS_DRIVER_OVERVOLTAGE_ITLK | FAC_OS_DRIVER1_OVERCURRENT_ITLK | FAC_OS_DRIVER2_OVERCURRENT_ITLK)) Led9TurnOff();
+    else if(fac_os.AlarmSts & (FAC_OS_DRIVER_OVERVOLTAGE_ALM | FAC_OS_DRIVER1_OVERCURRENT_ALM | FAC_OS_DRIVER2_OVERCURRENT_ALM)) Led9Toggle();
     else Led9TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Temperatura PCB e Umidade Relativa
-    if(fac_os.BoardTemperatureItlkSts || fac_os.RelativeHumidityItlkSts) Led10TurnOff();
-    else if(fac_os.BoardTemperatureAlarmSts || fac_os.RelativeHumidityAlarmSts) Led10Toggle();
+    if(fac_os.ItlkSts & (FAC_OS_BOARD_IIB_OVERTEMP_ITLK | FAC_OS_BOARD_IIB_OVERHUMIDITY_ITLK)) Led10TurnOff();
+    else if(fac_os.AlarmSts & (FAC_OS_BOARD_IIB_OVERTEMP_ALM | FAC_OS_BOARD_IIB_OVERHUMIDITY_ALM)) Led10Toggle();
     else Led10TurnOn();
 }
 
@@ -231,191 +183,178 @@ void check_fac_os_indication_leds()
 
 void fac_os_application_readings()
 {
+    uint32_t alarms = 0;
+
     //PT100 CH1 Dissipador
     fac_os.TempHeatSink.f = Pt100Ch1Read();
-    fac_os.TempHeatSinkAlarmSts = Pt100Ch1AlarmStatusRead();
-    if(!fac_os.TempHeatSinkItlkSts)fac_os.TempHeatSinkItlkSts = Pt100Ch1TripStatusRead();
+    if(Pt100Ch1AlarmStatusRead()) alarms |= FAC_OS_HS_OVERTEMP_ALM;
+    if(Pt100Ch1TripStatusRead()) fac_os.ItlkSts |= FAC_OS_HS_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //PT100 CH2 Indutor
     fac_os.TempL.f = Pt100Ch2Read();
-    fac_os.TempLAlarmSts = Pt100Ch2AlarmStatusRead();
-    if(!fac_os.TempLItlkSts)fac_os.TempLItlkSts = Pt100Ch2TripStatusRead();
+    if(Pt100Ch2AlarmStatusRead()) alarms |= FAC_OS_INDUC_OVERTEMP_ALM;
+    if(Pt100Ch2TripStatusRead()) fac_os.ItlkSts |= FAC_OS_INDUC_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT1
     fac_os.TempIGBT1.f = TempIgbt1Read();
-    fac_os.TempIGBT1AlarmSts = TempIgbt1AlarmStatusRead();
-    if(!fac_os.TempIGBT1ItlkSts)fac_os.TempIGBT1ItlkSts = TempIgbt1TripStatusRead();
+    if(TempIgbt1AlarmStatusRead()) alarms |= FAC_OS_IGBT1_OVERTEMP_ALM;
+    if(TempIgbt1TripStatusRead()) fac_os.ItlkSts |= FAC_OS_IGBT1_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT1 Hardware
     fac_os.TempIGBT1HwrItlk = Driver1OverTempRead();//Variavel usada para debug
-    if(!fac_os.TempIGBT1HwrItlkSts)fac_os.TempIGBT1HwrItlkSts = Driver1OverTempRead();
+    if(Driver1OverTempRead()) fac_os.ItlkSts |= FAC_OS_IGBT1_HWR_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT2
     fac_os.TempIGBT2.f = TempIgbt2Read();
-    fac_os.TempIGBT2AlarmSts = TempIgbt2AlarmStatusRead();
-    if(!fac_os.TempIGBT2ItlkSts)fac_os.TempIGBT2ItlkSts = TempIgbt2TripStatusRead();
+    if(TempIgbt2AlarmStatusRead()) alarms |= FAC_OS_IGBT2_OVERTEMP_ALM;
+    if(TempIgbt2TripStatusRead()) fac_os.ItlkSts |= FAC_OS_IGBT2_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT2 Hardware
     fac_os.TempIGBT2HwrItlk = Driver2OverTempRead();//Variavel usada para debug
-    if(!fac_os.TempIGBT2HwrItlkSts)fac_os.TempIGBT2HwrItlkSts = Driver2OverTempRead();
+    if(Driver2OverTempRead()) fac_os.ItlkSts |= FAC_OS_IGBT2_HWR_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura PCB IIB
     fac_os.BoardTemperature.f = BoardTempRead();
-    fac_os.BoardTemperatureAlarmSts = BoardTempAlarmStatusRead();
+    if(BoardTempAlarmStatusRead()) alarms |= FAC_OS_BOARD_IIB_OVERTEMP_ALM;
 
-#if (ItlkBoardTempEnable == 1)
-
-    if(!fac_os.BoardTemperatureItlkSts)fac_os.BoardTemperatureItlkSts = BoardTempTripStatusRead();
-
-#endif
+    if(BoardTempTripStatusRead()) fac_os.ItlkSts |= FAC_OS_BOARD_IIB_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Umidade Relativa
     fac_os.RelativeHumidity.f = RhRead();
-    fac_os.RelativeHumidityAlarmSts = RhAlarmStatusRead();
-
-#if (ItlkRhEnable == 1)
+    if(RhAlarmStatusRead()) alarms |= FAC_OS_BOARD_IIB_OVERHUMIDITY_ALM;
 
-    if(!fac_os.RelativeHumidityItlkSts)fac_os.RelativeHumidityItlkSts = RhTripStatusRead();
-
-#endif
+    if(RhTripStatusRead()) fac_os.ItlkSts |= FAC_OS_BOARD_IIB_OVERHUMIDITY_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //DriverVotage
     fac_os.DriverVoltage.f = DriverVoltageRead();
-    fac_os.DriverVoltageAlarmSts = DriverVoltageAlarmStatusRead();
-    if(!fac_os.DriverVoltageItlkSts)fac_os.DriverVoltageItlkSts = DriverVolatgeTripStatusRead();
+    if(DriverVoltageAlarmStatusRead()) alarms |= FAC_OS_DRIVER_OVERVOLTAGE_ALM;
+    if(DriverVolatgeTripStatusRead()) fac_os.ItlkSts |= FAC_OS_DRIVER_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Drive1Current
     fac_os.Driver1Current.f = Driver1CurrentRead();
-    fac_os.Driver1CurrentAlarmSts = Driver1CurrentAlarmStatusRead();
-    if(!fac_os.Driver1CurrentItlkSts)fac_os.Driver1CurrentItlkSts = Driver1CurrentTripStatusRead();
+    if(Driver1CurrentAlarmStatusRead()) alarms |= FAC_OS_DRIVER1_OVERCURRENT_ALM;
+    if(Driver1CurrentTripStatusRead()) fac_os.ItlkSts |= FAC_OS_DRIVER1_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Drive2Current
     fac_os.Driver2Current.f = Driver2CurrentRead();
-    fac_os.Driver2CurrentAlarmSts = Driver2CurrentAlarmStatusRead();
-    if(!fac_os.Driver2CurrentItlkSts)fac_os.Driver2CurrentItlkSts = Driver2CurrentTripStatusRead();
+    if(Driver2CurrentAlarmStatusRead()) alarms |= FAC_OS_DRIVER2_OVERCURRENT_ALM;
+    if(Driver2CurrentTripStatusRead()) fac_os.ItlkSts |= FAC_OS_DRIVER2_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     fac_os.VdcLink.f = LvCurrentCh1Read();
-    fac_os.VdcLinkAlarmSts = LvCurrentCh1AlarmStatusRead();
-    if(!fac_os.VdcLinkItlkSts)fac_os.VdcLinkItlkSts = LvCurrentCh1TripStatusRead();
+    if(LvCurrentCh1AlarmStatusRead()) alarms |= FAC_OS_INPUT_OVERVOLTAGE_ALM;
+    if(LvCurrentCh1TripStatusRead()) fac_os.ItlkSts |= FAC_OS_INPUT_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Medida de Fuga para o Terra
     fac_os.GroundLeakage.f = LvCurrentCh3Read();
-    fac_os.GroundLeakageAlarmSts = LvCurrentCh3AlarmStatusRead();
-    if(!fac_os.GroundLeakageItlkSts)fac_os.GroundLeakageItlkSts = LvCurrentCh3TripStatusRead();
+    if(LvCurrentCh3AlarmStatusRead()) alarms |= FAC_OS_GROUND_LKG_ALM;
+    if(LvCurrentCh3TripStatusRead()) fac_os.ItlkSts |= FAC_OS_GROUND_LKG_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     fac_os.Iin.f = CurrentCh1Read();
-    fac_os.IinAlarmSts = CurrentCh1AlarmStatusRead();
-    if(!fac_os.IinItlkSts)fac_os.IinItlkSts = CurrentCh1TripStatusRead();
+    if(CurrentCh1AlarmStatusRead()) alarms |= FAC_OS_INPUT_OVERCURRENT_ALM;
+    if(CurrentCh1TripStatusRead()) fac_os.ItlkSts |= FAC_OS_INPUT_OVERCURRENT_ITLK;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //RMS e ripple da corrente de entrada e do DC link, na janela do adc_rms
+    fac_os.IinRms.f = AdcRmsRead(FAC_OS_RMS_IIN);
+    fac_os.IinRipple.f = AdcRippleRead(FAC_OS_RMS_IIN);
+    if(AdcRmsAlarmStatusRead(FAC_OS_RMS_IIN)) alarms |= FAC_OS_INPUT_RMS_ALM;
+
+    fac_os.VdcLinkRms.f = AdcRmsRead(FAC_OS_RMS_VDCLINK);
+    fac_os.VdcLinkRipple.f = AdcRippleRead(FAC_OS_RMS_VDCLINK);
+    if(AdcRippleAlarmStatusRead(FAC_OS_RMS_VDCLINK)) alarms |= FAC_OS_DCLINK_RIPPLE_ALM;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     fac_os.Iout.f = CurrentCh2Read();
-    fac_os.IoutAlarmSts = CurrentCh2AlarmStatusRead();
-    if(!fac_os.IoutItlkSts)fac_os.IoutItlkSts = CurrentCh2TripStatusRead();
+    if(CurrentCh2AlarmStatusRead()) alarms |= FAC_OS_OUTPUT_OVERCURRENT_ALM;
+    if(CurrentCh2TripStatusRead()) fac_os.ItlkSts |= FAC_OS_OUTPUT_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Erro do Driver 1 Top
     fac_os.Driver1ErrorTop = Driver1TopErrorRead();//Variavel usada para debug
-    if(!fac_os.Driver1ErrorTopItlkSts)fac_os.Driver1ErrorTopItlkSts = Driver1TopErrorRead();
+    if(Driver1TopErrorRead()) fac_os.ItlkSts |= FAC_OS_DRIVER1_ERROR_TOP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Erro do Driver 1 Bot
     fac_os.Driver1ErrorBot = Driver1BotErrorRead();//Variavel usada para debug
-    if(!fac_os.Driver1ErrorBotItlkSts)fac_os.Driver1ErrorBotItlkSts = Driver1BotErrorRead();
+    if(Driver1BotErrorRead()) fac_os.ItlkSts |= FAC_OS_DRIVER1_ERROR_BOT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Erro do Driver 2 Top
     fac_os.Driver2ErrorTop = Driver2TopErrorRead();//Variavel usada para debug
-    if(!fac_os.Driver2ErrorTopItlkSts)fac_os.Driver2ErrorTopItlkSts = Driver2TopErrorRead();
+    if(Driver2TopErrorRead()) fac_os.ItlkSts |= FAC_OS_DRIVER2_ERROR_TOP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Erro do Driver 2 Bot
     fac_os.Driver2ErrorBot = Driver2BotErrorRead();//Variavel usada para debug
-    if(!fac_os.Driver2ErrorBotItlkSts)fac_os.Driver2ErrorBotItlkSts = Driver2BotErrorRead();
+    if(Driver2BotErrorRead()) fac_os.ItlkSts |= FAC_OS_DRIVER2_ERROR_BOT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Se nao houver sinal na entrada digital dos 6 sinais, defina a acao como Interlock.
-    if(fac_os.Driver1ErrorTopItlkSts || fac_os.Driver1ErrorBotItlkSts || fac_os.Driver2ErrorTopItlkSts || fac_os.Driver2ErrorBotItlkSts
-       || fac_os.TempIGBT1HwrItlkSts || fac_os.TempIGBT2HwrItlkSts) InterlockSet();
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-    if (fac_os.VdcLinkItlkSts)              itlk_id |= FAC_OS_INPUT_OVERVOLTAGE_ITLK;
-    if (fac_os.IinItlkSts)                  itlk_id |= FAC_OS_INPUT_OVERCURRENT_ITLK;
-    if (fac_os.IoutItlkSts)                 itlk_id |= FAC_OS_OUTPUT_OVERCURRENT_ITLK;
-    if (fac_os.TempIGBT1ItlkSts)            itlk_id |= FAC_OS_IGBT1_OVERTEMP_ITLK;
-    if (fac_os.TempIGBT1HwrItlkSts)         itlk_id |= FAC_OS_IGBT1_HWR_OVERTEMP_ITLK;
-    if (fac_os.TempIGBT2ItlkSts)            itlk_id |= FAC_OS_IGBT2_OVERTEMP_ITLK;
-    if (fac_os.TempIGBT2HwrItlkSts)         itlk_id |= FAC_OS_IGBT2_HWR_OVERTEMP_ITLK;
-    if (fac_os.DriverVoltageItlkSts)        itlk_id |= FAC_OS_DRIVER_OVERVOLTAGE_ITLK;
-    if (fac_os.Driver1CurrentItlkSts)       itlk_id |= FAC_OS_DRIVER1_OVERCURRENT_ITLK;
-    if (fac_os.Driver2CurrentItlkSts)       itlk_id |= FAC_OS_DRIVER2_OVERCURRENT_ITLK;
-    if (fac_os.Driver1ErrorTopItlkSts)      itlk_id |= FAC_OS_DRIVER1_ERROR_TOP_ITLK;
-    if (fac_os.Driver1ErrorBotItlkSts)      itlk_id |= FAC_OS_DRIVER1_ERROR_BOT_ITLK;
-    if (fac_os.Driver2ErrorTopItlkSts)      itlk_id |= FAC_OS_DRIVER2_ERROR_TOP_ITLK;
-    if (fac_os.Driver2ErrorBotItlkSts)      itlk_id |= FAC_OS_DRIVER2_ERROR_BOT_ITLK;
-    if (fac_os.TempLItlkSts)                itlk_id |= FAC_OS_INDUC_OVERTEMP_ITLK;
-    if (fac_os.TempHeatSinkItlkSts)         itlk_id |= FAC_OS_HS_OVERTEMP_ITLK;
-    if (fac_os.GroundLeakageItlkSts)        itlk_id |= FAC_OS_GROUND_LKG_ITLK;
-    if (fac_os.BoardTemperatureItlkSts)     itlk_id |= FAC_OS_BOARD_IIB_OVERTEMP_ITLK;
-    if (fac_os.RelativeHumidityItlkSts)     itlk_id |= FAC_OS_BOARD_IIB_OVERHUMIDITY_ITLK;
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-    if (fac_os.VdcLinkAlarmSts)             alarm_id |= FAC_OS_INPUT_OVERVOLTAGE_ALM;
-    if (fac_os.IinAlarmSts)                 alarm_id |= FAC_OS_INPUT_OVERCURRENT_ALM;
-    if (fac_os.IoutAlarmSts)                alarm_id |= FAC_OS_OUTPUT_OVERCURRENT_ALM;
-    if (fac_os.TempIGBT1AlarmSts)           alarm_id |= FAC_OS_IGBT1_OVERTEMP_ALM;
-    if (fac_os.TempIGBT2AlarmSts)           alarm_id |= FAC_OS_IGBT2_OVERTEMP_ALM;
-    if (fac_os.DriverVoltageAlarmSts)       alarm_id |= FAC_OS_DRIVER_OVERVOLTAGE_ALM;
-    if (fac_os.Driver1CurrentAlarmSts)      alarm_id |= FAC_OS_DRIVER1_OVERCURRENT_ALM;
-    if (fac_os.Driver2CurrentAlarmSts)      alarm_id |= FAC_OS_DRIVER2_OVERCURRENT_ALM;
-    if (fac_os.TempLAlarmSts)               alarm_id |= FAC_OS_INDUC_OVERTEMP_ALM;
-    if (fac_os.TempHeatSinkAlarmSts)        alarm_id |= FAC_OS_HS_OVERTEMP_ALM;
-    if (fac_os.GroundLeakageAlarmSts)       alarm_id |= FAC_OS_GROUND_LKG_ALM;
-    if (fac_os.BoardTemperatureAlarmSts)    alarm_id |= FAC_OS_BOARD_IIB_OVERTEMP_ALM;
-    if (fac_os.RelativeHumidityAlarmSts)    alarm_id |= FAC_OS_BOARD_IIB_OVERHUMIDITY_ALM;
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-    fac_os_interlocks_indication = itlk_id;
-    fac_os_alarms_indication = alarm_id;
-
-    g_controller_iib.iib_itlk[0].u32        = fac_os_interlocks_indication;
+    if(fac_os.ItlkSts & (FAC_OS_DRIVER1_ERROR_TOP_ITLK | FAC_OS_DRIVER1_ERROR_BOT_ITLK | FAC_OS_DRIVER2_ERROR_TOP_ITLK | FAC_OS_DRIVER2_ERROR_BOT_ITLK
+       | FAC_OS_IGBT1_HWR_OVERTEMP_ITLK | FAC_OS_IGBT2_HWR_OVERTEMP_ITLK)) InterlockSet();
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Inclinacao das temperaturas (dT/dt)
+    if(TempSlopeAlarmStatusRead()) alarms |= FAC_OS_TEMP_SLOPE_ALM;
+    if(TempSlopeTripStatusRead()) fac_os.ItlkSts |= FAC_OS_TEMP_SLOPE_ITLK;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Risco de condensacao: ponto de orvalho contra o lado frio
+    fac_os.DewPoint.f = DewPointRead();
+    if(DewPointAlarmStatusRead()) alarms |= FAC_OS_CONDENSATION_ALM;
+    if(DewPointTripStatusRead()) fac_os.ItlkSts |= FAC_OS_CONDENSATION_ITLK;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Sensor PT100 falho: nao confiar na ultima leitura mantida
+    if(Pt100Ch1FailureRead() || Pt100Ch2FailureRead() || Pt100Ch3FailureRead() || Pt100Ch4FailureRead()) alarms |= FAC_OS_PT100_SENSOR_FAIL_ALM;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    fac_os.AlarmSts = alarms;
+
+    // Alarmes ficam registrados no quadro ate o proximo clear
+    alarm_id |= fac_os.AlarmSts;
+
+    g_controller_iib.iib_itlk[0].u32        = fac_os.ItlkSts;
     g_controller_iib.iib_itlk[1].u32        = ResetInterlocksRegister;
 
-    g_controller_iib.iib_alarm[0].u32       = fac_os_alarms_indication;
+    g_controller_iib.iib_alarm[0].u32       = alarm_id;
     g_controller_iib.iib_alarm[1].u32       = ResetAlarmsRegister;
 
     g_controller_iib.iib_signals[0].f       = fac_os.VdcLink.f;
@@ -431,6 +370,11 @@ void fac_os_application_readings()
     g_controller_iib.iib_signals[10].f      = fac_os.TempHeatSink.f;
     g_controller_iib.iib_signals[11].f      = fac_os.BoardTemperature.f;
     g_controller_iib.iib_signals[12].f      = fac_os.RelativeHumidity.f;
+    g_controller_iib.iib_signals[13].f      = fac_os.IinRms.f;
+    g_controller_iib.iib_signals[14].f      = fac_os.IinRipple.f;
+    g_controller_iib.iib_signals[15].f      = fac_os.VdcLinkRms.f;
+    g_controller_iib.iib_signals[16].f      = fac_os.VdcLinkRipple.f;
+    g_controller_iib.iib_signals[17].f      = fac_os.DewPoint.f;
 
 }
 
@@ -463,6 +407,11 @@ void config_module_fac_os(void)
     LvCurrentCh3AlarmLevelSet(FAC_OS_GROUND_LEAKAGE_ALM_LIM);
     LvCurrentCh3TripLevelSet(FAC_OS_GROUND_LEAKAGE_ITLK_LIM);
 
+    /* RMS of the input current and DC link ripple; the ripple limit is set at commissioning */
+    AdcRmsInit(FAC_OS_RMS_IIN, ADC_INPUT_CURRENT_CH1, ADC_RMS_WINDOW_MS);
+    AdcRmsInit(FAC_OS_RMS_VDCLINK, ADC_INPUT_LV_CURRENT_CH1, ADC_RMS_WINDOW_MS);
+    AdcRmsAlarmLevelSet(FAC_OS_RMS_IIN, FAC_OS_INPUT_OVERCURRENT_ALM_LIM, 0.0);
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //PT100 configuration
@@ -498,6 +447,7 @@ void config_module_fac_os(void)
 
     //Temperature Board configuration
     BoardTempDelay(Delay_BoardTemp); //Inserir valor de delay
+    BoardTempItlkEnable(ItlkBoardTempEnable);
 
     //Temp board configuration limits
     BoardTempAlarmLevelSet(FAC_OS_BOARD_OVERTEMP_ALM_LIM);
@@ -507,11 +457,21 @@ void config_module_fac_os(void)
 
     //Humidity Board configuration
     RhDelay(Delay_BoardRh); //Inserir valor de delay
+    RhItlkEnable(ItlkRhEnable);
 
     //Rh configuration limits
     RhAlarmLevelSet(FAC_OS_RH_OVERHUMIDITY_ALM_LIM);
     RhTripLevelSet(FAC_OS_RH_OVERHUMIDITY_ITLK_LIM);
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Ponto de orvalho contra o PT100 do dissipador (lado da agua)
+#if (Pt100Ch1Enable == ON)
+    DewPointInit(DEW_POINT_PT100_CH1);
+#else
+    DewPointInit(0);
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Driver Voltage configuration
@@ -544,56 +504,31 @@ void config_module_fac_os(void)
 
     //Init Variables
     fac_os.Iin.f                        = 0.0;
-    fac_os.IinAlarmSts                  = 0;
-    fac_os.IinItlkSts                   = 0;
     fac_os.Iout.f                       = 0.0;
-    fac_os.IoutAlarmSts                 = 0;
-    fac_os.IoutItlkSts                  = 0;
+    fac_os.IinRms.f                     = 0.0;
+    fac_os.IinRipple.f                  = 0.0;
+    fac_os.VdcLinkRms.f                 = 0.0;
+    fac_os.VdcLinkRipple.f              = 0.0;
     fac_os.VdcLink.f                    = 0.0;
-    fac_os.VdcLinkAlarmSts              = 0;
-    fac_os.VdcLinkItlkSts               = 0;
     fac_os.TempIGBT1.f                  = 0.0;
-    fac_os.TempIGBT1AlarmSts            = 0;
-    fac_os.TempIGBT1ItlkSts             = 0;
     fac_os.TempIGBT1HwrItlk             = 0;
-    fac_os.TempIGBT1HwrItlkSts          = 0;
     fac_os.TempIGBT2.f                  = 0.0;
-    fac_os.TempIGBT2AlarmSts            = 0;
-    fac_os.TempIGBT2ItlkSts             = 0;
     fac_os.TempIGBT2HwrItlk             = 0;
-    fac_os.TempIGBT2HwrItlkSts          = 0;
     fac_os.DriverVoltage.f              = 0.0;
-    fac_os.DriverVoltageAlarmSts        = 0;
-    fac_os.DriverVoltageItlkSts         = 0;
     fac_os.Driver1Current.f             = 0.0;
-    fac_os.Driver1CurrentAlarmSts       = 0;
-    fac_os.Driver1CurrentItlkSts        = 0;
     fac_os.Driver2Current.f             = 0.0;
-    fac_os.Driver2CurrentAlarmSts       = 0;
-    fac_os.Driver2CurrentItlkSts        = 0;
     fac_os.Driver1ErrorTop              = 0;
-    fac_os.Driver1ErrorTopItlkSts       = 0;
     fac_os.Driver1ErrorBot              = 0;
-    fac_os.Driver1ErrorBotItlkSts       = 0;
     fac_os.Driver2ErrorTop              = 0;
-    fac_os.Driver2ErrorTopItlkSts       = 0;
     fac_os.Driver2ErrorBot              = 0;
-    fac_os.Driver2ErrorBotItlkSts       = 0;
     fac_os.GroundLeakage.f              = 0.0;
-    fac_os.GroundLeakageAlarmSts        = 0;
-    fac_os.GroundLeakageItlkSts         = 0;
     fac_os.TempL.f                      = 0.0;
-    fac_os.TempLAlarmSts                = 0;
-    fac_os.TempLItlkSts                 = 0;
     fac_os.TempHeatSink.f               = 0.0;
-    fac_os.TempHeatSinkAlarmSts         = 0;
-    fac_os.TempHeatSinkItlkSts          = 0;
     fac_os.BoardTemperature.f           = 0.0;
-    fac_os.BoardTemperatureAlarmSts     = 0;
-    fac_os.BoardTemperatureItlkSts      = 0;
     fac_os.RelativeHumidity.f           = 0.0;
-    fac_os.RelativeHumidityAlarmSts     = 0;
-    fac_os.RelativeHumidityItlkSts      = 0;
+    fac_os.DewPoint.f                   = 0.0;
+    fac_os.ItlkSts                      = 0;
+    fac_os.AlarmSts                     = 0;
 
 }
 
@@ -29,6 +29,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "application.h"
+#include "telemetry.h"
+#include "capture.h"
+#include "adc_rms.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,120 +42,103 @@ typedef struct
         uint8_t     u8[4];
     } Iin;
 
-    bool IinAlarmSts;
-    bool IinItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Iout;
 
-    bool IoutAlarmSts;
-    bool IoutItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } IinRms;
 
     union {
         float       f;
         uint8_t     u8[4];
-    } VdcLink;
+    } IinRipple;
 
-    bool VdcLinkAlarmSts;
-    bool VdcLinkItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } VdcLinkRms;
 
     union {
         float       f;
         uint8_t     u8[4];
-    } TempIGBT1;
+    } VdcLinkRipple;
 
-    bool TempIGBT1AlarmSts;
-    bool TempIGBT1ItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } VdcLink;
+
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } TempIGBT1;
     bool TempIGBT1HwrItlk;
-    bool TempIGBT1HwrItlkSts;
 
     union {
         float       f;
         uint8_t     u8[4];
     } TempIGBT2;
-
-    bool TempIGBT2AlarmSts;
-    bool TempIGBT2ItlkSts;
     bool TempIGBT2HwrItlk;
-    bool TempIGBT2HwrItlkSts;
 
     union {
         float       f;
         uint8_t     u8[4];
     } DriverVoltage;
 
-    bool DriverVoltageAlarmSts;
-    bool DriverVoltageItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Driver1Current;
 
-    bool Driver1CurrentAlarmSts;
-    bool Driver1CurrentItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Driver2Current;
 
-    bool Driver2CurrentAlarmSts;
-    bool Driver2CurrentItlkSts;
-
     bool Driver1ErrorTop;
-    bool Driver1ErrorTopItlkSts;
 
     bool Driver1ErrorBot;
-    bool Driver1ErrorBotItlkSts;
 
     bool Driver2ErrorTop;
-    bool Driver2ErrorTopItlkSts;
 
     bool Driver2ErrorBot;
-    bool Driver2ErrorBotItlkSts;
 
     union {
         float       f;
         uint8_t     u8[4];
     } TempL;
 
-    bool TempLAlarmSts;
-    bool TempLItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } TempHeatSink;
 
-    bool TempHeatSinkAlarmSts;
-    bool TempHeatSinkItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } GroundLeakage;
 
-    bool GroundLeakageAlarmSts;
-    bool GroundLeakageItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } BoardTemperature;
 
-    bool BoardTemperatureAlarmSts;
-    bool BoardTemperatureItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } RelativeHumidity;
 
-    bool RelativeHumidityAlarmSts;
-    bool RelativeHumidityItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } DewPoint;
+
+    uint32_t ItlkSts;       // FAC_OS_*_ITLK, travados ate o clear
+    uint32_t AlarmSts;      // FAC_OS_*_ALM, estado atual
 
 } fac_os_t;
 
@@ -177,6 +163,8 @@ typedef struct
 #define FAC_OS_GROUND_LKG_ITLK              0x00010000
 #define FAC_OS_BOARD_IIB_OVERTEMP_ITLK      0x00020000
 #define FAC_OS_BOARD_IIB_OVERHUMIDITY_ITLK  0x00040000
+#define FAC_OS_TEMP_SLOPE_ITLK              0x00080000
+#define FAC_OS_CONDENSATION_ITLK            0x00100000
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -193,6 +181,29 @@ typedef struct
 #define FAC_OS_GROUND_LKG_ALM               0x00000400
 #define FAC_OS_BOARD_IIB_OVERTEMP_ALM       0x00000800
 #define FAC_OS_BOARD_IIB_OVERHUMIDITY_ALM   0x00001000
+#define FAC_OS_INPUT_RMS_ALM                0x00002000
+#define FAC_OS_DCLINK_RIPPLE_ALM            0x00004000
+#define FAC_OS_TEMP_SLOPE_ALM               0x00008000
+#define FAC_OS_CONDENSATION_ALM             0x00010000
+#define FAC_OS_PT100_SENSOR_FAIL_ALM        0x00020000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quantidade de sinais publicados em iib_signals
+#define FAC_OS_NUM_SIGNALS                  18
+
+// Slots do adc_rms usados pelo modulo
+#define FAC_OS_RMS_IIN                      0
+#define FAC_OS_RMS_VDCLINK                  1
+
+// Canais do ADC interno registrados pela captura pos-interlock
+#define FAC_OS_CAPTURE_CHANNELS             (CAPTURE_CURRENT_CH1 | \
+                                             CAPTURE_CURRENT_CH2 | \
+                                             CAPTURE_LV_CURRENT_CH1 | \
+                                             CAPTURE_LV_CURRENT_CH3 | \
+                                             CAPTURE_DRIVER_VOLTAGE | \
+                                             CAPTURE_DRIVER1_CURRENT | \
+                                             CAPTURE_DRIVER2_CURRENT)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -205,6 +216,7 @@ extern void fac_os_application_readings(void);
 extern void config_module_fac_os(void);
 
 extern fac_os_t fac_os;
+extern const telemetry_signal_cfg_t fac_os_telemetry_cfg[FAC_OS_NUM_SIGNALS];
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -30,6 +30,9 @@
 #include "BoardTempHum.h"
 #include "ntc_isolated_i2c.h"
 #include "pt100.h"
+#include "temp_slope.h"
+#include "dew_point.h"
+#include "plausibility.h"
 #include "output.h"
 #include "leds.h"
 #include "can_bus.h"
@@ -49,15 +52,49 @@ fap_t fap;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t fap_interlocks_indication;
-static uint32_t fap_alarms_indication;
+// Deadband absoluto, deadband relativo e periodo de envio de cada sinal
+const telemetry_signal_cfg_t fap_telemetry_cfg[FAP_NUM_SIGNALS] =
+{
+    { 1.0,  0.01,  1000 },   //  0 Vin
+    { 1.0,  0.01,  1000 },   //  1 Vout
+    { 0.5,  0.01,   500 },   //  2 IoutA1
+    { 0.5,  0.01,   500 },   //  3 IoutA2
+    { 0.5,  0.0,   5000 },   //  4 TempIGBT1
+    { 0.5,  0.0,   5000 },   //  5 TempIGBT2
+    { 0.1,  0.0,   5000 },   //  6 DriverVoltage
+    { 0.05, 0.0,   5000 },   //  7 Driver1Current
+    { 0.05, 0.0,   5000 },   //  8 Driver2Current
+    { 0.5,  0.0,   5000 },   //  9 TempL
+    { 0.5,  0.0,   5000 },   // 10 TempHeatSink
+    { 0.5,  0.01,  1000 },   // 11 GroundLeakage
+    { 0.5,  0.0,  10000 },   // 12 BoardTemperature
+    { 1.0,  0.0,  10000 },   // 13 RelativeHumidity
+    { 0.5,  0.01,  2000 },   // 14 IoutA1Rms
+    { 0.5,  0.01,  2000 },   // 15 IoutA1Ripple
+    { 0.5,  0.01,  2000 },   // 16 IoutA2Rms
+    { 0.5,  0.01,  2000 },   // 17 IoutA2Ripple
+    { 1.0,  0.0,   2000 },   // 18 TempJunction1
+    { 1.0,  0.0,   2000 },   // 19 TempJunction2
+    { 0.5,  0.0,  10000 }    // 20 DewPoint
+};
+
+// Modelo termico tipico de modulo IGBT 1200V/300A, juncao ate o NTC da base.
+// Perdas de conduo com o IGBT conduzindo todo o periodo (Duty = 1) e
+// chaveamento de 30mJ a 300A e 10kHz; ajustar ao modulo montado.
+static const igbt_thermal_model_t fap_igbt_model =
+{
+    0.8, 0.0035, 1.0, 1.0,
+    { 0.004, 0.020, 0.050, 0.026 },
+    { 0.001, 0.010, 0.060, 0.400 }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
 
 static uint32_t ResetInterlocksRegister = 0;
 static uint32_t ResetAlarmsRegister = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-static uint32_t itlk_id;
 static uint32_t alarm_id;
 
 static uint8_t flag1 = 0;
@@ -70,8 +107,6 @@ static uint32_t FiltroUP2 = 1024;
 
 void clear_fap_interlocks()
 {
-    fap.RelayOpenItlkSts = 0;
-    fap.RelayContactStickingItlkSts = 0;
     fap.ReleAuxItlkSts = 0;
     fap.ReleExtItlkSts = 0;
 
@@ -83,75 +118,21 @@ void clear_fap_interlocks()
 
 ////////////////////////////////////////
 
-    fap.VinItlkSts               = 0;
-    fap.VoutItlkSts              = 0;
-    fap.IoutA1ItlkSts            = 0;
-    fap.IoutA2ItlkSts            = 0;
-    fap.TempIGBT1ItlkSts         = 0;
-    fap.TempIGBT2ItlkSts         = 0;
-    fap.Driver1ErrorItlkSts      = 0;
-    fap.Driver2ErrorItlkSts      = 0;
-    fap.TempLItlkSts             = 0;
-    fap.TempHeatSinkItlkSts      = 0;
-    fap.ExternalItlkSts          = 0;
-    fap.RackItlkSts              = 0;
-    fap.GroundLeakageItlkSts     = 0;
-    fap.DriverVoltageItlkSts     = 0;
-    fap.Driver1CurrentItlkSts    = 0;
-    fap.Driver2CurrentItlkSts    = 0;
-    fap.BoardTemperatureItlkSts  = 0;
-    fap.RelativeHumidityItlkSts  = 0;
-
-    itlk_id = 0;
-
+    fap.ItlkSts = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 uint8_t check_fap_interlocks()
 {
-    uint8_t test = 0;
-
-    test |= fap.VinItlkSts;
-    test |= fap.VoutItlkSts;
-    test |= fap.IoutA1ItlkSts;
-    test |= fap.IoutA2ItlkSts;
-    test |= fap.TempIGBT1ItlkSts;
-    test |= fap.TempIGBT2ItlkSts;
-    test |= fap.Driver1ErrorItlkSts;
-    test |= fap.Driver2ErrorItlkSts;
-    test |= fap.TempLItlkSts;
-    test |= fap.TempHeatSinkItlkSts;
-    test |= fap.ExternalItlkSts;
-    test |= fap.RackItlkSts;
-    test |= fap.GroundLeakageItlkSts;
-    test |= fap.DriverVoltageItlkSts;
-    test |= fap.Driver1CurrentItlkSts;
-    test |= fap.Driver2CurrentItlkSts;
-    test |= fap.BoardTemperatureItlkSts;
-    test |= fap.RelativeHumidityItlkSts;
-
-    return test;
+    return ((fap.ItlkSts & FAP_ITLK_TRIP_MASK) != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void clear_fap_alarms()
 {
-    fap.VinAlarmSts               = 0;
-    fap.VoutAlarmSts              = 0;
-    fap.IoutA1AlarmSts            = 0;
-    fap.IoutA2AlarmSts            = 0;
-    fap.TempIGBT1AlarmSts         = 0;
-    fap.TempIGBT2AlarmSts         = 0;
-    fap.TempLAlarmSts             = 0;
-    fap.TempHeatSinkAlarmSts      = 0;
-    fap.GroundLeakageAlarmSts     = 0;
-    fap.DriverVoltageAlarmSts     = 0;
-    fap.Driver1CurrentAlarmSts    = 0;
-    fap.Driver2CurrentAlarmSts    = 0;
-    fap.BoardTemperatureAlarmSts  = 0;
-    fap.RelativeHumidityAlarmSts  = 0;
+    fap.AlarmSts = 0;
 
     alarm_id = 0;
 
@@ -161,24 +142,7 @@ void clear_fap_alarms()
 
 uint8_t check_fap_alarms()
 {
-    uint8_t test = 0;
-
-    test |= fap.VinAlarmSts;
-    test |= fap.VoutAlarmSts;
-    test |= fap.IoutA1AlarmSts;
-    test |= fap.IoutA2AlarmSts;
-    test |= fap.TempIGBT1AlarmSts;
-    test |= fap.TempIGBT2AlarmSts;
-    test |= fap.TempLAlarmSts;
-    test |= fap.TempHeatSinkAlarmSts;
-    test |= fap.GroundLeakageAlarmSts;
-    test |= fap.DriverVoltageAlarmSts;
-    test |= fap.Driver1CurrentAlarmSts;
-    test |= fap.Driver2CurrentAlarmSts;
-    test |= fap.BoardTemperatureAlarmSts;
-    test |= fap.RelativeHumidityAlarmSts;
-
-    return test;
+    return (fap.AlarmSts != 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -186,62 +150,62 @@ uint8_t check_fap_alarms()
 void check_fap_indication_leds()
 {
     //Output over voltage
-    if(fap.VoutItlkSts) Led2TurnOff();
-    else if(fap.VoutAlarmSts) Led2Toggle();
+    if(fap.ItlkSts & FAP_OUTPUT_OVERVOLTAGE_ITLK) Led2TurnOff();
+    else if(fap.AlarmSts & FAP_OUTPUT_OVERVOLTAGE_ALM) Led2Toggle();
     else Led2TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Input over voltage
-    if(fap.VinItlkSts) Led3TurnOff();
-    else if(fap.VinAlarmSts) Led3Toggle();
+    if(fap.ItlkSts & FAP_INPUT_OVERVOLTAGE_ITLK) Led3TurnOff();
+    else if(fap.AlarmSts & FAP_INPUT_OVERVOLTAGE_ALM) Led3Toggle();
     else Led3TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Output over current
-    if(fap.IoutA1ItlkSts || fap.IoutA2ItlkSts) Led4TurnOff();
-    else if(fap.IoutA1AlarmSts || fap.IoutA2AlarmSts) Led4Toggle();
+    if(fap.ItlkSts & (FAP_OUTPUT_OVERCURRENT_1_ITLK | FAP_OUTPUT_OVERCURRENT_2_ITLK)) Led4TurnOff();
+    else if(fap.AlarmSts & (FAP_OUTPUT_OVERCURRENT_1_ALM | FAP_OUTPUT_OVERCURRENT_2_ALM)) Led4Toggle();
     else Led4TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Over temperature
-    if(fap.TempIGBT1ItlkSts || fap.TempIGBT2ItlkSts ||  fap.TempLItlkSts || fap.TempHeatSinkItlkSts) Led5TurnOff();
-    else if(fap.TempIGBT1AlarmSts || fap.TempIGBT2AlarmSts ||  fap.TempLAlarmSts || fap.TempHeatSinkAlarmSts) Led5Toggle();
+    if(fap.ItlkSts & (FAP_IGBT1_OVERTEMP_ITLK | FAP_IGBT2_OVERTEMP_ITLK | FAP_INDUC_OVERTEMP_ITLK | FAP_HS_OVERTEMP_ITLK)) Led5TurnOff();
+    else if(fap.AlarmSts & (FAP_IGBT1_OVERTEMP_ALM | FAP_IGBT2_OVERTEMP_ALM | FAP_INDUC_OVERTEMP_ALM | FAP_HS_OVERTEMP_ALM)) Led5Toggle();
     else Led5TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Externo
-    if(fap.ExternalItlkSts) Led6TurnOff();
+    if(fap.ItlkSts & FAP_EXTERNAL_ITLK) Led6TurnOff();
     else Led6TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Fuga para o Terra
-    if(fap.GroundLeakageItlkSts) Led7TurnOff();
-    else if(fap.GroundLeakageAlarmSts) Led7Toggle();
+    if(fap.ItlkSts & FAP_GROUND_LKG_ITLK) Led7TurnOff();
+    else if(fap.AlarmSts & FAP_GROUND_LKG_ALM) Led7Toggle();
     else Led7TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock do Rack
-    if(fap.RackItlkSts) Led8TurnOff();
+    if(fap.ItlkSts & FAP_RACK_ITLK) Led8TurnOff();
     else Led8TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlocks dos Drivers
-    if(fap.Driver1ErrorItlkSts || fap.Driver2ErrorItlkSts || fap.DriverVoltageItlkSts || fap.Driver1CurrentItlkSts || fap.Driver2CurrentItlkSts) Led9TurnOff();
-    else if(fap.DriverVoltageAlarmSts || fap.Driver1CurrentAlarmSts || fap.Driver2CurrentAlarmSts) Led9Toggle();
+    if(fap.ItlkSts & (FAP_DRIVER1_ERROR_ITLK | FAP_DRIVER2_ERROR_ITLK | FAP_DRIVER_OVERVOLTAGE_ITLK | FAP_DRIVER1_OVERCURRENT_ITLK | FAP_DRIVER2_OVERCURRENT_ITLK)) Led9TurnOff();
+    else if(fap.AlarmSts & (FAP_DRIVER_OVERVOLTAGE_ALM | FAP_DRIVER1_OVERCURRENT_ALM | FAP_DRIVER2_OVERCURRENT_ALM)) Led9Toggle();
     else Led9TurnOn();
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Interlock Temperatura PCB e Umidade Relativa
-    if(fap.BoardTemperatureItlkSts || fap.RelativeHumidityItlkSts) Led10TurnOff();
-    else if(fap.BoardTemperatureAlarmSts || fap.RelativeHumidityAlarmSts) Led10Toggle();
+    if(fap.ItlkSts & (FAP_BOARD_IIB_OVERTEMP_ITLK | FAP_BOARD_IIB_OVERHUMIDITY_ITLK)) Led10TurnOff();
+    else if(fap.AlarmSts & (FAP_BOARD_IIB_OVERTEMP_ALM | FAP_BOARD_IIB_OVERHUMIDITY_ALM)) Led10Toggle();
     else Led10TurnOn();
 }
 
@@ -249,111 +213,127 @@ void check_fap_indication_leds()
 
 void fap_application_readings()
 {
+    uint32_t alarms = 0;
+
     //PT100 CH1 Dissipador
     fap.TempHeatSink.f = Pt100Ch1Read();
-    fap.TempHeatSinkAlarmSts = Pt100Ch1AlarmStatusRead();
-    if(!fap.TempHeatSinkItlkSts)fap.TempHeatSinkItlkSts = Pt100Ch1TripStatusRead();
+    if(Pt100Ch1AlarmStatusRead()) alarms |= FAP_HS_OVERTEMP_ALM;
+    if(Pt100Ch1TripStatusRead()) fap.ItlkSts |= FAP_HS_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //PT100 CH2 Indutor
     fap.TempL.f = Pt100Ch2Read();
-    fap.TempLAlarmSts = Pt100Ch2AlarmStatusRead();
-    if(!fap.TempLItlkSts)fap.TempLItlkSts = Pt100Ch2TripStatusRead();
+    if(Pt100Ch2AlarmStatusRead()) alarms |= FAP_INDUC_OVERTEMP_ALM;
+    if(Pt100Ch2TripStatusRead()) fap.ItlkSts |= FAP_INDUC_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT1
     fap.TempIGBT1.f = TempIgbt1Read();
-    fap.TempIGBT1AlarmSts = TempIgbt1AlarmStatusRead();
-    if(!fap.TempIGBT1ItlkSts)fap.TempIGBT1ItlkSts = TempIgbt1TripStatusRead();
+    if(TempIgbt1AlarmStatusRead()) alarms |= FAP_IGBT1_OVERTEMP_ALM;
+    if(TempIgbt1TripStatusRead()) fap.ItlkSts |= FAP_IGBT1_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperatura IGBT2
     fap.TempIGBT2.f = TempIgbt2Read();
-    fap.TempIGBT2AlarmSts = TempIgbt2AlarmStatusRead();
-    if(!fap.TempIGBT2ItlkSts)fap.TempIGBT2ItlkSts = TempIgbt2TripStatusRead();
+    if(TempIgbt2AlarmStatusRead()) alarms |= FAP_IGBT2_OVERTEMP_ALM;
+    if(TempIgbt2TripStatusRead()) fap.ItlkSts |= FAP_IGBT2_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-    //Temperatura PCB IIB
-    fap.BoardTemperature.f = BoardTempRead();
-    fap.BoardTemperatureAlarmSts = BoardTempAlarmStatusRead();
+    //Temperatura de juncao estimada dos IGBTs
+    fap.TempJunction1.f = IgbtJunctionRead(IGBT_THERMAL_IGBT1);
+    if(IgbtJunctionAlarmStatusRead(IGBT_THERMAL_IGBT1)) alarms |= FAP_IGBT1_JUNCTION_OVERTEMP_ALM;
+    if(IgbtJunctionTripStatusRead(IGBT_THERMAL_IGBT1)) fap.ItlkSts |= FAP_IGBT1_JUNCTION_OVERTEMP_ITLK;
 
-#if (ItlkBoardTempEnable == 1)
+    fap.TempJunction2.f = IgbtJunctionRead(IGBT_THERMAL_IGBT2);
+    if(IgbtJunctionAlarmStatusRead(IGBT_THERMAL_IGBT2)) alarms |= FAP_IGBT2_JUNCTION_OVERTEMP_ALM;
+    if(IgbtJunctionTripStatusRead(IGBT_THERMAL_IGBT2)) fap.ItlkSts |= FAP_IGBT2_JUNCTION_OVERTEMP_ITLK;
 
-    if(!fap.BoardTemperatureItlkSts)fap.BoardTemperatureItlkSts = BoardTempTripStatusRead();
+/////////////////////////////////////////////////////////////////////////////////////////////
 
-#endif
+    //Temperatura PCB IIB
+    fap.BoardTemperature.f = BoardTempRead();
+    if(BoardTempAlarmStatusRead()) alarms |= FAP_BOARD_IIB_OVERTEMP_ALM;
+
+    if(BoardTempTripStatusRead()) fap.ItlkSts |= FAP_BOARD_IIB_OVERTEMP_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Umidade Relativa
     fap.RelativeHumidity.f = RhRead();
-    fap.RelativeHumidityAlarmSts = RhAlarmStatusRead();
+    if(RhAlarmStatusRead()) alarms |= FAP_BOARD_IIB_OVERHUMIDITY_ALM;
 
-#if (ItlkRhEnable == 1)
-
-    if(!fap.RelativeHumidityItlkSts)fap.RelativeHumidityItlkSts = RhTripStatusRead();
-
-#endif
+    if(RhTripStatusRead()) fap.ItlkSts |= FAP_BOARD_IIB_OVERHUMIDITY_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //DriverVotage
     fap.DriverVoltage.f = DriverVoltageRead();
-    fap.DriverVoltageAlarmSts = DriverVoltageAlarmStatusRead();
-    if(!fap.DriverVoltageItlkSts)fap.DriverVoltageItlkSts = DriverVolatgeTripStatusRead();
+    if(DriverVoltageAlarmStatusRead()) alarms |= FAP_DRIVER_OVERVOLTAGE_ALM;
+    if(DriverVolatgeTripStatusRead()) fap.ItlkSts |= FAP_DRIVER_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Drive1Current
     fap.Driver1Current.f = Driver1CurrentRead();
-    fap.Driver1CurrentAlarmSts = Driver1CurrentAlarmStatusRead();
-    if(!fap.Driver1CurrentItlkSts)fap.Driver1CurrentItlkSts = Driver1CurrentTripStatusRead();
+    if(Driver1CurrentAlarmStatusRead()) alarms |= FAP_DRIVER1_OVERCURRENT_ALM;
+    if(Driver1CurrentTripStatusRead()) fap.ItlkSts |= FAP_DRIVER1_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Drive2Current
     fap.Driver2Current.f = Driver2CurrentRead();
-    fap.Driver2CurrentAlarmSts = Driver2CurrentAlarmStatusRead();
-    if(!fap.Driver2CurrentItlkSts)fap.Driver2CurrentItlkSts = Driver2CurrentTripStatusRead();
+    if(Driver2CurrentAlarmStatusRead()) alarms |= FAP_DRIVER2_OVERCURRENT_ALM;
+    if(Driver2CurrentTripStatusRead()) fap.ItlkSts |= FAP_DRIVER2_OVERCURRENT_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Corrente de Saida IGBT1
     fap.IoutA1.f = CurrentCh1Read();//HALL CH1
-    fap.IoutA1AlarmSts = CurrentCh1AlarmStatusRead();
-    if(!fap.IoutA1ItlkSts)fap.IoutA1ItlkSts = CurrentCh1TripStatusRead();
+    if(CurrentCh1AlarmStatusRead()) alarms |= FAP_OUTPUT_OVERCURRENT_1_ALM;
+    if(CurrentCh1TripStatusRead()) fap.ItlkSts |= FAP_OUTPUT_OVERCURRENT_1_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Corrente de Saida IGBT2
     fap.IoutA2.f = CurrentCh2Read();//HALL CH2
-    fap.IoutA2AlarmSts = CurrentCh2AlarmStatusRead();
-    if(!fap.IoutA2ItlkSts)fap.IoutA2ItlkSts = CurrentCh2TripStatusRead();
+    if(CurrentCh2AlarmStatusRead()) alarms |= FAP_OUTPUT_OVERCURRENT_2_ALM;
+    if(CurrentCh2TripStatusRead()) fap.ItlkSts |= FAP_OUTPUT_OVERCURRENT_2_ITLK;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //RMS e ripple das correntes dos bracos, na janela do adc_rms
+    fap.IoutA1Rms.f = AdcRmsRead(FAP_RMS_IOUT_A1);
+    fap.IoutA1Ripple.f = AdcRippleRead(FAP_RMS_IOUT_A1);
+    if(AdcRmsAlarmStatusRead(FAP_RMS_IOUT_A1)) alarms |= FAP_OUTPUT_RMS_1_ALM;
+
+    fap.IoutA2Rms.f = AdcRmsRead(FAP_RMS_IOUT_A2);
+    fap.IoutA2Ripple.f = AdcRippleRead(FAP_RMS_IOUT_A2);
+    if(AdcRmsAlarmStatusRead(FAP_RMS_IOUT_A2)) alarms |= FAP_OUTPUT_RMS_2_ALM;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Tensao de Entrada
     fap.Vin.f = LvCurrentCh1Read();
-    fap.VinAlarmSts = LvCurrentCh1AlarmStatusRead();
-    if(!fap.VinItlkSts)fap.VinItlkSts = LvCurrentCh1TripStatusRead();
+    if(LvCurrentCh1AlarmStatusRead()) alarms |= FAP_INPUT_OVERVOLTAGE_ALM;
+    if(LvCurrentCh1TripStatusRead()) fap.ItlkSts |= FAP_INPUT_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Tensao de Saida
     fap.Vout.f = LvCurrentCh2Read();
-    fap.VoutAlarmSts = LvCurrentCh2AlarmStatusRead();
-    if(!fap.VoutItlkSts)fap.VoutItlkSts = LvCurrentCh2TripStatusRead();
+    if(LvCurrentCh2AlarmStatusRead()) alarms |= FAP_OUTPUT_OVERVOLTAGE_ALM;
+    if(LvCurrentCh2TripStatusRead()) fap.ItlkSts |= FAP_OUTPUT_OVERVOLTAGE_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Medida de Fuga para o Terra
     fap.GroundLeakage.f = LvCurrentCh3Read();
-    fap.GroundLeakageAlarmSts = LvCurrentCh3AlarmStatusRead();
-    if(!fap.GroundLeakageItlkSts)fap.GroundLeakageItlkSts = LvCurrentCh3TripStatusRead();
+    if(LvCurrentCh3AlarmStatusRead()) alarms |= FAP_GROUND_LKG_ALM;
+    if(LvCurrentCh3TripStatusRead()) fap.ItlkSts |= FAP_GROUND_LKG_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -361,7 +341,7 @@ void fap_application_readings()
 
     //Interlock externo
     fap.ExternalItlk = Gpdi5Read();//Variavel usada para debug
-    if(!fap.ExternalItlkSts)fap.ExternalItlkSts = Gpdi5Read();
+    if(Gpdi5Read()) fap.ItlkSts |= FAP_EXTERNAL_ITLK;
 
 #endif
 
@@ -371,7 +351,7 @@ void fap_application_readings()
 
     //Interlock externo
     fap.ExternalItlk = Gpdi5Read();//Variavel usada para debug
-    if(!fap.ExternalItlkSts)fap.ExternalItlkSts = Gpdi5Read();
+    if(Gpdi5Read()) fap.ItlkSts |= FAP_EXTERNAL_ITLK;
 
 #endif
 
@@ -381,7 +361,7 @@ void fap_application_readings()
 
     //Interlock externo
     fap.ExternalItlk = Gpdi1Read();//Variavel usada para debug
-    if(!fap.ExternalItlkSts)fap.ExternalItlkSts = Gpdi1Read();
+    if(Gpdi1Read()) fap.ItlkSts |= FAP_EXTERNAL_ITLK;
 
 #endif
 
@@ -391,7 +371,7 @@ void fap_application_readings()
 
     //Interlock do Rack
     fap.Rack = Gpdi6Read();//Variavel usada para debug
-    if(!fap.RackItlkSts)fap.RackItlkSts = Gpdi6Read();
+    if(Gpdi6Read()) fap.ItlkSts |= FAP_RACK_ITLK;
 
 #endif
 
@@ -401,7 +381,7 @@ void fap_application_readings()
 
     //Interlock do Rack
     fap.Rack = Gpdi7Read();//Variavel usada para debug
-    if(!fap.RackItlkSts)fap.RackItlkSts = Gpdi7Read();
+    if(Gpdi7Read()) fap.ItlkSts |= FAP_RACK_ITLK;
 
 #endif
 
@@ -411,7 +391,7 @@ void fap_application_readings()
 
     //Interlock do Rack
     fap.Rack = Gpdi3Read();//Variavel usada para debug
-    if(!fap.RackItlkSts)fap.RackItlkSts = Gpdi3Read();
+    if(Gpdi3Read()) fap.ItlkSts |= FAP_RACK_ITLK;
 
 #endif
 
@@ -446,13 +426,13 @@ void fap_application_readings()
 
     //Erro do Driver 1
     fap.Driver1Error = Driver1TopErrorRead();//Variavel usada para debug
-    if(!fap.Driver1ErrorItlkSts)fap.Driver1ErrorItlkSts = Driver1TopErrorRead();
+    if(Driver1TopErrorRead()) fap.ItlkSts |= FAP_DRIVER1_ERROR_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Erro do Driver 2
     fap.Driver2Error = Driver2TopErrorRead();//Variavel usada para debug
-    if(!fap.Driver2ErrorItlkSts)fap.Driver2ErrorItlkSts = Driver2TopErrorRead();
+    if(Driver2TopErrorRead()) fap.ItlkSts |= FAP_DRIVER2_ERROR_ITLK;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -464,8 +444,7 @@ void fap_application_readings()
     {
         if(!FiltroUP1)
         {
-            fap.RelayOpenItlkSts = 1;
-            fap.RelayContactStickingItlkSts = 0;
+            fap.ItlkSts |= FAP_RELAY_ITLK;
 
             FiltroUP1 = 1024;
             flag1 = 1;
@@ -485,8 +464,7 @@ void fap_application_readings()
     {
         if(!FiltroUP2)
         {
-            fap.RelayContactStickingItlkSts = 1;
-            fap.RelayOpenItlkSts = 0;
+            fap.ItlkSts |= FAP_RELAY_CONTACT_STICKING_ITLK;
 
             FiltroUP2 = 1024;
             flag2 = 1;
@@ -503,57 +481,46 @@ void fap_application_readings()
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Se nao houver sinal na entrada digital dos 4 sinais, defina a acao como Interlock.
-    if(fap.ExternalItlkSts || fap.RackItlkSts || fap.Driver1ErrorItlkSts || fap.Driver2ErrorItlkSts) InterlockSet();
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-    if (fap.VinItlkSts)                     itlk_id |= FAP_INPUT_OVERVOLTAGE_ITLK;
-    if (fap.VoutItlkSts)                    itlk_id |= FAP_OUTPUT_OVERVOLTAGE_ITLK;
-    if (fap.IoutA1ItlkSts)                  itlk_id |= FAP_OUTPUT_OVERCURRENT_1_ITLK;
-    if (fap.IoutA2ItlkSts)                  itlk_id |= FAP_OUTPUT_OVERCURRENT_2_ITLK;
-    if (fap.TempIGBT1ItlkSts)               itlk_id |= FAP_IGBT1_OVERTEMP_ITLK;
-    if (fap.TempIGBT2ItlkSts)               itlk_id |= FAP_IGBT2_OVERTEMP_ITLK;
-    if (fap.DriverVoltageItlkSts)           itlk_id |= FAP_DRIVER_OVERVOLTAGE_ITLK;
-    if (fap.Driver1CurrentItlkSts)          itlk_id |= FAP_DRIVER1_OVERCURRENT_ITLK;
-    if (fap.Driver2CurrentItlkSts)          itlk_id |= FAP_DRIVER2_OVERCURRENT_ITLK;
-    if (fap.Driver1ErrorItlkSts)            itlk_id |= FAP_DRIVER1_ERROR_ITLK;
-    if (fap.Driver2ErrorItlkSts)            itlk_id |= FAP_DRIVER2_ERROR_ITLK;
-    if (fap.TempLItlkSts)                   itlk_id |= FAP_INDUC_OVERTEMP_ITLK;
-    if (fap.TempHeatSinkItlkSts)            itlk_id |= FAP_HS_OVERTEMP_ITLK;
-    if (fap.RelayOpenItlkSts)               itlk_id |= FAP_RELAY_ITLK;
-    if (fap.RelayContactStickingItlkSts)    itlk_id |= FAP_RELAY_CONTACT_STICKING_ITLK;
-    if (fap.ExternalItlkSts)                itlk_id |= FAP_EXTERNAL_ITLK;
-    if (fap.RackItlkSts)                    itlk_id |= FAP_RACK_ITLK;
-    if (fap.GroundLeakageItlkSts)           itlk_id |= FAP_GROUND_LKG_ITLK;
-    if (fap.BoardTemperatureItlkSts)        itlk_id |= FAP_BOARD_IIB_OVERTEMP_ITLK;
-    if (fap.RelativeHumidityItlkSts)        itlk_id |= FAP_BOARD_IIB_OVERHUMIDITY_ITLK;
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-    if (fap.VinAlarmSts)                    alarm_id |= FAP_INPUT_OVERVOLTAGE_ALM;
-    if (fap.VoutAlarmSts)                   alarm_id |= FAP_OUTPUT_OVERVOLTAGE_ALM;
-    if (fap.IoutA1AlarmSts)                 alarm_id |= FAP_OUTPUT_OVERCURRENT_1_ALM;
-    if (fap.IoutA2AlarmSts)                 alarm_id |= FAP_OUTPUT_OVERCURRENT_2_ALM;
-    if (fap.TempIGBT1AlarmSts)              alarm_id |= FAP_IGBT1_OVERTEMP_ALM;
-    if (fap.TempIGBT2AlarmSts)              alarm_id |= FAP_IGBT2_OVERTEMP_ALM;
-    if (fap.TempLAlarmSts)                  alarm_id |= FAP_INDUC_OVERTEMP_ALM;
-    if (fap.TempHeatSinkAlarmSts)           alarm_id |= FAP_HS_OVERTEMP_ALM;
-    if (fap.GroundLeakageAlarmSts)          alarm_id |= FAP_GROUND_LKG_ALM;
-    if (fap.DriverVoltageAlarmSts)          alarm_id |= FAP_DRIVER_OVERVOLTAGE_ALM;
-    if (fap.Driver1CurrentAlarmSts)         alarm_id |= FAP_DRIVER1_OVERCURRENT_ALM;
-    if (fap.Driver2CurrentAlarmSts)         alarm_id |= FAP_DRIVER2_OVERCURRENT_ALM;
-    if (fap.BoardTemperatureAlarmSts)       alarm_id |= FAP_BOARD_IIB_OVERTEMP_ALM;
-    if (fap.RelativeHumidityAlarmSts)       alarm_id |= FAP_BOARD_IIB_OVERHUMIDITY_ALM;
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-    fap_interlocks_indication = itlk_id;
-    fap_alarms_indication = alarm_id;
-
-    g_controller_iib.iib_itlk[0].u32        = fap_interlocks_indication;
+    if(fap.ItlkSts & (FAP_EXTERNAL_ITLK | FAP_RACK_ITLK | FAP_DRIVER1_ERROR_ITLK | FAP_DRIVER2_ERROR_ITLK)) InterlockSet();
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Inclinacao das temperaturas (dT/dt)
+    if(TempSlopeAlarmStatusRead()) alarms |= FAP_TEMP_SLOPE_ALM;
+    if(TempSlopeTripStatusRead()) fap.ItlkSts |= FAP_TEMP_SLOPE_ITLK;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Risco de condensacao: ponto de orvalho contra o lado frio
+    fap.DewPoint.f = DewPointRead();
+    if(DewPointAlarmStatusRead()) alarms |= FAP_CONDENSATION_ALM;
+    if(DewPointTripStatusRead()) fap.ItlkSts |= FAP_CONDENSATION_ITLK;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Plausibilidade entre medidas redundantes
+    if(PlausibilityAlarmStatusRead(FAP_PLAUS_IOUT_IMBALANCE)) alarms |= FAP_IOUT_IMBALANCE_ALM;
+    if(PlausibilityAlarmStatusRead(FAP_PLAUS_VOUT_OVER_VIN)) alarms |= FAP_VOUT_OVER_VIN_ALM;
+
+    if(PlausibilityAlarmStatusRead(FAP_PLAUS_STUCK_HS) || PlausibilityAlarmStatusRead(FAP_PLAUS_STUCK_L) ||
+       PlausibilityAlarmStatusRead(FAP_PLAUS_STUCK_IGBT1) || PlausibilityAlarmStatusRead(FAP_PLAUS_STUCK_IGBT2)) alarms |= FAP_TEMP_SENSOR_STUCK_ALM;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Sensor PT100 falho: nao confiar na ultima leitura mantida
+    if(Pt100Ch1FailureRead() || Pt100Ch2FailureRead() || Pt100Ch3FailureRead() || Pt100Ch4FailureRead()) alarms |= FAP_PT100_SENSOR_FAIL_ALM;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    fap.AlarmSts = alarms;
+
+    // Alarmes ficam registrados no quadro ate o proximo clear
+    alarm_id |= fap.AlarmSts;
+
+    g_controller_iib.iib_itlk[0].u32        = fap.ItlkSts;
     g_controller_iib.iib_itlk[1].u32        = ResetInterlocksRegister;
 
-    g_controller_iib.iib_alarm[0].u32       = fap_alarms_indication;
+    g_controller_iib.iib_alarm[0].u32       = alarm_id;
     g_controller_iib.iib_alarm[1].u32       = ResetAlarmsRegister;
 
     g_controller_iib.iib_signals[0].f       = fap.Vin.f;
@@ -570,11 +537,39 @@ void fap_application_readings()
     g_controller_iib.iib_signals[11].f      = fap.GroundLeakage.f;
     g_controller_iib.iib_signals[12].f      = fap.BoardTemperature.f;
     g_controller_iib.iib_signals[13].f      = fap.RelativeHumidity.f;
+    g_controller_iib.iib_signals[14].f      = fap.IoutA1Rms.f;
+    g_controller_iib.iib_signals[15].f      = fap.IoutA1Ripple.f;
+    g_controller_iib.iib_signals[16].f      = fap.IoutA2Rms.f;
+    g_controller_iib.iib_signals[17].f      = fap.IoutA2Ripple.f;
+    g_controller_iib.iib_signals[18].f      = fap.TempJunction1.f;
+    g_controller_iib.iib_signals[19].f      = fap.TempJunction2.f;
+    g_controller_iib.iib_signals[20].f      = fap.DewPoint.f;
 
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+#ifdef FAP
+
+// Regras STUCK dos PT100 so com leitura atual (fora de OK o canal repete a ultima)
+#if (Pt100Ch1Enable == ON)
+static unsigned char fap_pt100_ch1_ok(void)
+{
+    return Pt100Ch1HealthRead() == PT100_HEALTH_OK;
+}
+#endif
+
+#if (Pt100Ch2Enable == ON)
+static unsigned char fap_pt100_ch2_ok(void)
+{
+    return Pt100Ch2HealthRead() == PT100_HEALTH_OK;
+}
+#endif
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 void config_module_fap(void)
 {
 
@@ -590,6 +585,14 @@ void config_module_fap(void)
     CurrentCh2AlarmLevelSet(FAP_OUTPUT_OVERCURRENT_2_ALM_LIM);  //Corrente brao2
     CurrentCh2TripLevelSet(FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM);  //Corrente brao2
 
+    //RMS dos bracos: limite proprio, abaixo do alarme instantaneo (o RMS nunca passa do pico)
+    AdcRmsInit(FAP_RMS_IOUT_A1, ADC_INPUT_CURRENT_CH1, ADC_RMS_WINDOW_MS);
+    AdcRmsInit(FAP_RMS_IOUT_A2, ADC_INPUT_CURRENT_CH2, ADC_RMS_WINDOW_MS);
+    AdcRmsAlarmLevelSet(FAP_RMS_IOUT_A1, FAP_OUTPUT_RMS_1_ALM_LIM, 0.0);
+    AdcRmsAlarmLevelSet(FAP_RMS_IOUT_A2, FAP_OUTPUT_RMS_2_ALM_LIM, 0.0);
+    AdcRmsAlarmDelay(FAP_RMS_IOUT_A1, FAP_OUTPUT_RMS_ALM_DELAY_MS);
+    AdcRmsAlarmDelay(FAP_RMS_IOUT_A2, FAP_OUTPUT_RMS_ALM_DELAY_MS);
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Leitura de tenso isolada
@@ -635,10 +638,56 @@ void config_module_fap(void)
     TempIgbt2AlarmLevelSet(FAP_IGBT2_OVERTEMP_ALM_LIM);
     TempIgbt2TripLevelSet(FAP_IGBT2_OVERTEMP_ITLK_LIM);
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Juncao dos IGBTs: perdas pela corrente do braco, ancorada no NTC do modulo
+    IgbtThermalInit(IGBT_THERMAL_IGBT1, &fap_igbt_model, &CurrentCh1.Value, &TempNtcIgbt1.Value);
+    IgbtThermalInit(IGBT_THERMAL_IGBT2, &fap_igbt_model, &CurrentCh2.Value, &TempNtcIgbt2.Value);
+
+    IgbtJunctionDelay(IGBT_THERMAL_IGBT1, FAP_IGBT_JUNCTION_DELAY_MS);
+    IgbtJunctionDelay(IGBT_THERMAL_IGBT2, FAP_IGBT_JUNCTION_DELAY_MS);
+
+    IgbtJunctionAlarmLevelSet(IGBT_THERMAL_IGBT1, FAP_IGBT_JUNCTION_ALM_LIM);
+    IgbtJunctionTripLevelSet(IGBT_THERMAL_IGBT1, FAP_IGBT_JUNCTION_ITLK_LIM);
+    IgbtJunctionAlarmLevelSet(IGBT_THERMAL_IGBT2, FAP_IGBT_JUNCTION_ALM_LIM);
+    IgbtJunctionTripLevelSet(IGBT_THERMAL_IGBT2, FAP_IGBT_JUNCTION_ITLK_LIM);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Plausibilidade: um sensor morto le um valor valido e nunca dispara
+#if (CurrentCh1Enable == ON && CurrentCh2Enable == ON)
+    PlausibilityRuleInit(FAP_PLAUS_IOUT_IMBALANCE, PLAUSIBILITY_IMBALANCE, &CurrentCh1.Value, &CurrentCh2.Value,
+                         FAP_IOUT_IMBALANCE_LIM, FAP_IOUT_IMBALANCE_FLOOR, FAP_IOUT_IMBALANCE_DELAY_MS);
+#endif
+
+#if (LvCurrentCh1Enable == ON && LvCurrentCh2Enable == ON)
+    PlausibilityRuleInit(FAP_PLAUS_VOUT_OVER_VIN, PLAUSIBILITY_GREATER, &LvCurrentCh2.Value, &LvCurrentCh1.Value,
+                         FAP_VOUT_OVER_VIN_LIM, FAP_VOUT_OVER_VIN_FLOOR, FAP_VOUT_OVER_VIN_DELAY_MS);
+#endif
+
+#if (Pt100Ch1Enable == ON)
+    PlausibilityRuleInit(FAP_PLAUS_STUCK_HS, PLAUSIBILITY_STUCK, &Pt100Ch1.Temperature, 0, 0.0, 0.0, FAP_TEMP_STUCK_DELAY_MS);
+    PlausibilityRuleValid(FAP_PLAUS_STUCK_HS, fap_pt100_ch1_ok);
+#endif
+
+#if (Pt100Ch2Enable == ON)
+    PlausibilityRuleInit(FAP_PLAUS_STUCK_L, PLAUSIBILITY_STUCK, &Pt100Ch2.Temperature, 0, 0.0, 0.0, FAP_TEMP_STUCK_DELAY_MS);
+    PlausibilityRuleValid(FAP_PLAUS_STUCK_L, fap_pt100_ch2_ok);
+#endif
+
+#if (TempIgbt1Enable == ON)
+    PlausibilityRuleInit(FAP_PLAUS_STUCK_IGBT1, PLAUSIBILITY_STUCK, &TempNtcIgbt1.Value, 0, 0.0, 0.0, FAP_TEMP_STUCK_DELAY_MS);
+#endif
+
+#if (TempIgbt2Enable == ON)
+    PlausibilityRuleInit(FAP_PLAUS_STUCK_IGBT2, PLAUSIBILITY_STUCK, &TempNtcIgbt2.Value, 0, 0.0, 0.0, FAP_TEMP_STUCK_DELAY_MS);
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Temperature Board configuration
     BoardTempDelay(Delay_BoardTemp); //Inserir valor de delay
+    BoardTempItlkEnable(ItlkBoardTempEnable);
 
     //Temp board configuration limits
     BoardTempAlarmLevelSet(FAP_BOARD_OVERTEMP_ALM_LIM);
@@ -648,11 +697,21 @@ void config_module_fap(void)
 
     //Humidity Board configuration
     RhDelay(Delay_BoardRh); //Inserir valor de delay
+    RhItlkEnable(ItlkRhEnable);
 
     //Rh configuration limits
     RhAlarmLevelSet(FAP_RH_OVERHUMIDITY_ALM_LIM);
     RhTripLevelSet(FAP_RH_OVERHUMIDITY_ITLK_LIM);
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+    //Ponto de orvalho contra o PT100 do dissipador (lado da agua)
+#if (Pt100Ch1Enable == ON)
+    DewPointInit(DEW_POINT_PT100_CH1);
+#else
+    DewPointInit(0);
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //Driver Voltage configuration
@@ -685,60 +744,35 @@ void config_module_fap(void)
 
     //Init Variables
     fap.Vin.f                        = 0.0;
-    fap.VinAlarmSts                  = 0;
-    fap.VinItlkSts                   = 0;
     fap.Vout.f                       = 0.0;
-    fap.VoutAlarmSts                 = 0;
-    fap.VoutItlkSts                  = 0;
     fap.IoutA1.f                     = 0.0;
-    fap.IoutA1AlarmSts               = 0;
-    fap.IoutA1ItlkSts                = 0;
     fap.IoutA2.f                     = 0.0;
-    fap.IoutA2AlarmSts               = 0;
-    fap.IoutA2ItlkSts                = 0;
+    fap.IoutA1Rms.f                  = 0.0;
+    fap.IoutA1Ripple.f               = 0.0;
+    fap.IoutA2Rms.f                  = 0.0;
+    fap.IoutA2Ripple.f               = 0.0;
     fap.TempIGBT1.f                  = 0.0;
-    fap.TempIGBT1AlarmSts            = 0;
-    fap.TempIGBT1ItlkSts             = 0;
     fap.TempIGBT2.f                  = 0.0;
-    fap.TempIGBT2AlarmSts            = 0;
-    fap.TempIGBT2ItlkSts             = 0;
+    fap.TempJunction1.f              = 0.0;
+    fap.TempJunction2.f              = 0.0;
     fap.DriverVoltage.f              = 0.0;
-    fap.DriverVoltageAlarmSts        = 0;
-    fap.DriverVoltageItlkSts         = 0;
     fap.Driver1Current.f             = 0.0;
-    fap.Driver1CurrentAlarmSts       = 0;
-    fap.Driver1CurrentItlkSts        = 0;
     fap.Driver2Current.f             = 0.0;
-    fap.Driver2CurrentAlarmSts       = 0;
-    fap.Driver2CurrentItlkSts        = 0;
     fap.Driver1Error                 = 0;
-    fap.Driver1ErrorItlkSts          = 0;
     fap.Driver2Error                 = 0;
-    fap.Driver2ErrorItlkSts          = 0;
     fap.TempL.f                      = 0.0;
-    fap.TempLAlarmSts                = 0;
-    fap.TempLItlkSts                 = 0;
     fap.TempHeatSink.f               = 0.0;
-    fap.TempHeatSinkAlarmSts         = 0;
-    fap.TempHeatSinkItlkSts          = 0;
     fap.Relay                        = 0;
     fap.ExternalItlk                 = 0;
-    fap.ExternalItlkSts              = 0;
     fap.Rack                         = 0;
-    fap.RackItlkSts                  = 0;
     fap.GroundLeakage.f              = 0.0;
-    fap.GroundLeakageAlarmSts        = 0;
-    fap.GroundLeakageItlkSts         = 0;
     fap.BoardTemperature.f           = 0.0;
-    fap.BoardTemperatureAlarmSts     = 0;
-    fap.BoardTemperatureItlkSts      = 0;
     fap.RelativeHumidity.f           = 0.0;
-    fap.RelativeHumidityAlarmSts     = 0;
-    fap.RelativeHumidityItlkSts      = 0;
+    fap.DewPoint.f                   = 0.0;
     fap.ReleAuxItlkSts               = 0;
     fap.ReleExtItlkSts               = 0;
-    fap.RelayOpenItlkSts             = 0;
-    fap.RelayContactStickingItlkSts  = 0;
+    fap.ItlkSts                      = 0;
+    fap.AlarmSts                     = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,10 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "application.h"
+#include "telemetry.h"
+#include "capture.h"
+#include "adc_rms.h"
+#include "igbt_thermal.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,128 +43,118 @@ typedef struct
         uint8_t     u8[4];
     } Vin;
 
-    bool VinAlarmSts;
-    bool VinItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Vout;
 
-    bool VoutAlarmSts;
-    bool VoutItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } IoutA1;
 
-    bool IoutA1AlarmSts;
-    bool IoutA1ItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } IoutA2;
 
-    bool IoutA2AlarmSts;
-    bool IoutA2ItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } IoutA1Rms;
 
     union {
         float       f;
         uint8_t     u8[4];
-    } GroundLeakage;
+    } IoutA1Ripple;
 
-    bool GroundLeakageItlkSts;
-    bool GroundLeakageAlarmSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } IoutA2Rms;
 
     union {
         float       f;
         uint8_t     u8[4];
-    } TempIGBT1;
+    } IoutA2Ripple;
 
-    bool TempIGBT1AlarmSts;
-    bool TempIGBT1ItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } GroundLeakage;
+
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } TempIGBT1;
 
     union {
         float       f;
         uint8_t     u8[4];
     } TempIGBT2;
 
-    bool TempIGBT2AlarmSts;
-    bool TempIGBT2ItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } TempJunction1;
+
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } TempJunction2;
 
     union {
         float       f;
         uint8_t     u8[4];
     } DriverVoltage;
 
-    bool DriverVoltageAlarmSts;
-    bool DriverVoltageItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Driver1Current;
 
-    bool Driver1CurrentAlarmSts;
-    bool Driver1CurrentItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } Driver2Current;
 
-    bool Driver2CurrentAlarmSts;
-    bool Driver2CurrentItlkSts;
-
     bool Driver1Error;
-    bool Driver1ErrorItlkSts;
     bool Driver2Error;
-    bool Driver2ErrorItlkSts;
 
     union {
         float       f;
         uint8_t     u8[4];
     } TempL;
 
-    bool TempLAlarmSts;
-    bool TempLItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } TempHeatSink;
 
-    bool TempHeatSinkAlarmSts;
-    bool TempHeatSinkItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } BoardTemperature;
 
-    bool BoardTemperatureAlarmSts;
-    bool BoardTemperatureItlkSts;
-
     union {
         float       f;
         uint8_t     u8[4];
     } RelativeHumidity;
 
-    bool RelativeHumidityAlarmSts;
-    bool RelativeHumidityItlkSts;
+    union {
+        float       f;
+        uint8_t     u8[4];
+    } DewPoint;
 
     bool Relay;
     bool ExternalItlk;
-    bool ExternalItlkSts;
     bool Rack;
-    bool RackItlkSts;
 
     bool ReleAuxItlkSts;
     bool ReleExtItlkSts;
-    bool RelayOpenItlkSts;
-    bool RelayContactStickingItlkSts;
+
+    uint32_t ItlkSts;       // FAP_*_ITLK, travados ate o clear
+    uint32_t AlarmSts;      // FAP_*_ALM, estado atual
 
 } fap_t;
 
@@ -186,6 +180,13 @@ typedef struct
 #define FAP_GROUND_LKG_ITLK                 0x00020000
 #define FAP_BOARD_IIB_OVERTEMP_ITLK         0x00040000
 #define FAP_BOARD_IIB_OVERHUMIDITY_ITLK     0x00080000
+#define FAP_IGBT1_JUNCTION_OVERTEMP_ITLK    0x00100000
+#define FAP_IGBT2_JUNCTION_OVERTEMP_ITLK    0x00200000
+#define FAP_TEMP_SLOPE_ITLK                 0x00400000
+#define FAP_CONDENSATION_ITLK               0x00800000
+
+// Os interlocks do rele apenas sinalizam, nao entram em check_fap_interlocks()
+#define FAP_ITLK_TRIP_MASK                  (~(FAP_RELAY_ITLK | FAP_RELAY_CONTACT_STICKING_ITLK))
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -203,6 +204,67 @@ typedef struct
 #define FAP_GROUND_LKG_ALM                  0x00000800
 #define FAP_BOARD_IIB_OVERTEMP_ALM          0x00001000
 #define FAP_BOARD_IIB_OVERHUMIDITY_ALM      0x00002000
+#define FAP_OUTPUT_RMS_1_ALM                0x00004000
+#define FAP_OUTPUT_RMS_2_ALM                0x00008000
+#define FAP_IGBT1_JUNCTION_OVERTEMP_ALM     0x00010000
+#define FAP_IGBT2_JUNCTION_OVERTEMP_ALM     0x00020000
+#define FAP_TEMP_SLOPE_ALM                  0x00040000
+#define FAP_CONDENSATION_ALM                0x00080000
+#define FAP_IOUT_IMBALANCE_ALM              0x00100000
+#define FAP_VOUT_OVER_VIN_ALM               0x00200000
+#define FAP_TEMP_SENSOR_STUCK_ALM           0x00400000
+#define FAP_PT100_SENSOR_FAIL_ALM           0x00800000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quantidade de sinais publicados em iib_signals
+#define FAP_NUM_SIGNALS                     21
+
+// Slots do adc_rms usados pelo modulo
+#define FAP_RMS_IOUT_A1                     0
+#define FAP_RMS_IOUT_A2                     1
+
+// FAP_OUTPUT_RMS_n_ALM_LIM de cada fonte: 90% do alarme instantaneo, pois o
+// RMS nunca passa do pico. Precisa durar este tempo (multiplo da janela)
+#define FAP_OUTPUT_RMS_ALM_DELAY_MS         1000
+
+// Temperatura de juncao estimada: limites do componente, iguais para todas as fontes.
+// So alarme ate o modelo (Rth/tau) ser ajustado ao modulo montado; o trip e
+// ligado pelos parametros 131..138 (0 = desligado)
+#define FAP_IGBT_JUNCTION_ALM_LIM           125.0
+#define FAP_IGBT_JUNCTION_ITLK_LIM          0.0
+#define FAP_IGBT_JUNCTION_DELAY_MS          2
+
+// Slots do plausibility usados pelo modulo
+#define FAP_PLAUS_IOUT_IMBALANCE            0
+#define FAP_PLAUS_VOUT_OVER_VIN             1
+#define FAP_PLAUS_STUCK_HS                  2
+#define FAP_PLAUS_STUCK_L                   3
+#define FAP_PLAUS_STUCK_IGBT1               4
+#define FAP_PLAUS_STUCK_IGBT2               5
+
+// Desequilibrio dos bracos em % da maior corrente, avaliado acima de FLOOR (A)
+#define FAP_IOUT_IMBALANCE_LIM              20.0
+#define FAP_IOUT_IMBALANCE_FLOOR            10.0
+#define FAP_IOUT_IMBALANCE_DELAY_MS         500
+
+// Vout acima de Vin mais a margem (V)
+#define FAP_VOUT_OVER_VIN_LIM               5.0
+#define FAP_VOUT_OVER_VIN_FLOOR             10.0
+#define FAP_VOUT_OVER_VIN_DELAY_MS          100
+
+// Sensor de temperatura com a mesma leitura por 10 minutos
+#define FAP_TEMP_STUCK_DELAY_MS             600000
+
+// Canais do ADC interno registrados pela captura pos-interlock
+#define FAP_CAPTURE_CHANNELS                (CAPTURE_CURRENT_CH1 | \
+                                             CAPTURE_CURRENT_CH2 | \
+                                             CAPTURE_LV_CURRENT_CH1 | \
+                                             CAPTURE_LV_CURRENT_CH2 | \
+                                             CAPTURE_LV_CURRENT_CH3 | \
+                                             CAPTURE_DRIVER_VOLTAGE | \
+                                             CAPTURE_DRIVER1_CURRENT | \
+                                             CAPTURE_DRIVER2_CURRENT)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -215,6 +277,7 @@ extern void fap_application_readings(void);
 extern void config_module_fap(void);
 
 extern fap_t fap;
+extern const telemetry_signal_cfg_t fap_telemetry_cfg[FAP_NUM_SIGNALS];
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -243,6 +306,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        85.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       90.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                76.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                76.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -463,6 +529,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        85.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       90.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                76.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                76.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -683,6 +752,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        85.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       90.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                76.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                76.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -903,6 +975,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        85.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       90.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                76.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                76.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -1123,6 +1198,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        85.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       90.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                76.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                76.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -1343,6 +1421,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        90.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       95.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                81.0
+#define FAP_OUTPUT_RMS_2_ALM_LIM                81.0
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -1563,6 +1644,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        95.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       100.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                85.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                85.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -1785,6 +1869,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        90.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       100.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                81.0
+#define FAP_OUTPUT_RMS_2_ALM_LIM                81.0
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -2007,6 +2094,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        95.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       100.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                85.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                85.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -2229,6 +2319,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        90.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       100.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                81.0
+#define FAP_OUTPUT_RMS_2_ALM_LIM                81.0
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -2451,6 +2544,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        95.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       100.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                85.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                85.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -2671,6 +2767,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        115.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       130.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                103.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                103.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -2893,6 +2992,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        100.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       105.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                90.0
+#define FAP_OUTPUT_RMS_2_ALM_LIM                90.0
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -3115,6 +3217,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        151.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       152.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                135.9
+#define FAP_OUTPUT_RMS_2_ALM_LIM                135.9
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -3335,6 +3440,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        80.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       85.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                72.0
+#define FAP_OUTPUT_RMS_2_ALM_LIM                72.0
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              45.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             50.0
 
@@ -3553,6 +3661,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        115.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       120.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                103.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                103.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              40.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             45.0
 
@@ -3754,8 +3865,6 @@ extern fap_t fap;
 
 #ifdef GIGA_TESTES_IIBs
 
-#define Fast_CAN                                ON
-
 #define FAP
 
 #define ON                                      1
@@ -3773,6 +3882,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        115.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       120.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                103.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                103.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              40.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             45.0
 
@@ -3991,6 +4103,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        115.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       120.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                103.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                103.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              40.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             45.0
 
@@ -4209,6 +4324,9 @@ extern fap_t fap;
 #define FAP_OUTPUT_OVERCURRENT_2_ALM_LIM        115.0
 #define FAP_OUTPUT_OVERCURRENT_2_ITLK_LIM       120.0
 
+#define FAP_OUTPUT_RMS_1_ALM_LIM                103.5
+#define FAP_OUTPUT_RMS_2_ALM_LIM                103.5
+
 #define FAP_GROUND_LEAKAGE_ALM_LIM              40.0
 #define FAP_GROUND_LEAKAGE_ITLK_LIM             45.0
 
@@ -38,6 +38,8 @@
 #include "pt100.h"
 #include "task.h"
 #include "iib_data.h"
+#include "profile.h"
+#include "stack_monitor.h"
 
 #include <iib_modules/fap.h>
 #include <iib_modules/fac_os.h>
@@ -63,10 +65,14 @@ uint32_t SysCtlClockGetTM4C129(void)
  */
 int main(void)
 {
+    // Antes de qualquer interrupcao: a pintura mede o pior caso desde o reset
+    StackPaint();
 
     ui32SysClock = SysCtlClockFreqSet((SYSCTL_OSC_MAIN | SYSCTL_USE_PLL |
                                        SYSCTL_XTAL_25MHZ | SYSCTL_CFG_VCO_480), 120000000);
 
+    ProfileInit();
+
     pinout_config();
 
     init_control_framwork(&g_controller_iib);
@@ -90,16 +96,6 @@ int main(void)
 
     Timer_1ms_Init();
 
-/////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Usado para testes com leituras rapidas.
-
-#if (Fast_CAN == 1)
-
-    Timer_100ms_Init(); //10Hz
-
-#endif
-
 /////////////////////////////////////////////////////////////////////////////////////////////
 
     //PT100 channels initialization
@@ -29,6 +29,7 @@
 #include "peripheral_drivers/gpio/gpio_driver.h"
 #include "peripheral_drivers/i2c/i2c_driver.h"
 #include "board_drivers/hardware_def.h"
+#include "profile.h"
 
 #include <iib_modules/fap.h>
 #include <iib_modules/fac_os.h>
@@ -383,7 +384,14 @@ void NtcStartConversion(void)
 //******************************************************************************
 void NtcRead(void)
 {
-    TempNtcIgbt1.Value = GetTemperatureIgbt1((((float)ADS1x1x_read(&ntc_igbt1)*6.144)/2047.0));
+    // Leitura I2C fora da medicao de ciclos da conversao
+    float Voltage = (((float)ADS1x1x_read(&ntc_igbt1)*6.144)/2047.0);
+
+    PROFILE_START(PROFILE_NTC_TEMP);
+
+    TempNtcIgbt1.Value = GetTemperatureIgbt1(Voltage);
+
+    PROFILE_STOP(PROFILE_NTC_TEMP);
 
     if(TempNtcIgbt1.Value > TempNtcIgbt1.AlarmLimit)
     {
@@ -0,0 +1,484 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file parameters.c
+ * @brief Runtime parameter service over MESSAGE_PARAM_UDC.
+ *
+ * can_rx_dispatch() only stores the request; ParamService() decodes it in the
+ * main loop. The index of each parameter is its position in param_table[] and
+ * must not change between firmware versions: append new entries at the end.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/interrupt.h"
+#include "parameters.h"
+#include "adc_internal.h"
+#include "pt100.h"
+#include "ntc_isolated_i2c.h"
+#include "BoardTempHum.h"
+#include "can_bus.h"
+#include "can_health.h"
+#include "config_store.h"
+#include "application.h"
+#include "profile.h"
+#include "trip_latency.h"
+#include "stack_monitor.h"
+#include "adc_rms.h"
+#include "igbt_thermal.h"
+#include "temp_slope.h"
+#include "dew_point.h"
+#include "plausibility.h"
+#include "peripheral_drivers/timer/timer.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    void            *addr;
+    param_type_t    type;
+} param_entry_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Limites e atrasos dos canais com delay em microsegundos (amostrados a cada 100us)
+#define PARAM_CHANNEL_US(ch)    { &ch.AlarmLimit,       PARAM_FLOAT }, \
+                                { &ch.TripLimit,        PARAM_FLOAT }, \
+                                { &ch.Alarm_Delay_us,   PARAM_UINT  }, \
+                                { &ch.Itlk_Delay_us,    PARAM_UINT  }
+
+// Limites e atrasos dos canais com delay em milisegundos
+#define PARAM_CHANNEL_MS(ch)    { &ch.AlarmLimit,       PARAM_FLOAT }, \
+                                { &ch.TripLimit,        PARAM_FLOAT }, \
+                                { &ch.Alarm_Delay_ms,   PARAM_UINT  }, \
+                                { &ch.Itlk_Delay_ms,    PARAM_UINT  }
+
+// Calibracao dos canais do ADC interno
+#define PARAM_CALIBRATION(ch)   { &ch.Offset,           PARAM_CODE  }, \
+                                { &ch.Gain,             PARAM_FLOAT }
+
+// Janela e limites de alarme de um slot de RMS e ripple
+#define PARAM_RMS(slot)         { &AdcRms[slot].Window_ms,          PARAM_UINT  }, \
+                                { &AdcRms[slot].RmsAlarmLimit,      PARAM_FLOAT }, \
+                                { &AdcRms[slot].RippleAlarmLimit,   PARAM_FLOAT }
+
+// Limite e atraso de uma regra do plausibility
+#define PARAM_PLAUS(rule)       { &PlausibilityRule[rule].Limit,            PARAM_FLOAT }, \
+                                { &PlausibilityRule[rule].Alarm_Delay_ms,   PARAM_LONG  }
+
+static const param_entry_t param_table[] =
+{
+    PARAM_CHANNEL_US(CurrentCh1),           //  0 ..  3
+    PARAM_CHANNEL_US(CurrentCh2),           //  4 ..  7
+    PARAM_CHANNEL_US(CurrentCh3),           //  8 .. 11
+    PARAM_CHANNEL_US(CurrentCh4),           // 12 .. 15
+    PARAM_CHANNEL_US(LvCurrentCh1),         // 16 .. 19
+    PARAM_CHANNEL_US(LvCurrentCh2),         // 20 .. 23
+    PARAM_CHANNEL_US(LvCurrentCh3),         // 24 .. 27
+    PARAM_CHANNEL_US(VoltageCh1),           // 28 .. 31
+    PARAM_CHANNEL_US(VoltageCh2),           // 32 .. 35
+    PARAM_CHANNEL_US(VoltageCh3),           // 36 .. 39
+    PARAM_CHANNEL_US(VoltageCh4),           // 40 .. 43
+    PARAM_CHANNEL_MS(DriverVolt),           // 44 .. 47
+    PARAM_CHANNEL_MS(Driver1Curr),          // 48 .. 51
+    PARAM_CHANNEL_MS(Driver2Curr),          // 52 .. 55
+    PARAM_CHANNEL_MS(Pt100Ch1),             // 56 .. 59
+    PARAM_CHANNEL_MS(Pt100Ch2),             // 60 .. 63
+    PARAM_CHANNEL_MS(Pt100Ch3),             // 64 .. 67
+    PARAM_CHANNEL_MS(Pt100Ch4),             // 68 .. 71
+    PARAM_CHANNEL_MS(TempNtcIgbt1),         // 72 .. 75
+    PARAM_CHANNEL_MS(TempNtcIgbt2),         // 76 .. 79
+    PARAM_CHANNEL_MS(TemperatureBoard),     // 80 .. 83
+    PARAM_CHANNEL_MS(RelativeHumidity),     // 84 .. 87
+    { &TemperatureBoard.ItlkEnable, PARAM_FLAG },   // 88
+    { &RelativeHumidity.ItlkEnable, PARAM_FLAG },   // 89
+    PARAM_CALIBRATION(CurrentCh1),          //  90 ..  91
+    PARAM_CALIBRATION(CurrentCh2),          //  92 ..  93
+    PARAM_CALIBRATION(CurrentCh3),          //  94 ..  95
+    PARAM_CALIBRATION(CurrentCh4),          //  96 ..  97
+    PARAM_CALIBRATION(LvCurrentCh1),        //  98 ..  99
+    PARAM_CALIBRATION(LvCurrentCh2),        // 100 .. 101
+    PARAM_CALIBRATION(LvCurrentCh3),        // 102 .. 103
+    PARAM_CALIBRATION(VoltageCh1),          // 104 .. 105
+    PARAM_CALIBRATION(VoltageCh2),          // 106 .. 107
+    PARAM_CALIBRATION(VoltageCh3),          // 108 .. 109
+    PARAM_CALIBRATION(VoltageCh4),          // 110 .. 111
+    PARAM_CALIBRATION(DriverVolt),          // 112 .. 113
+    PARAM_CALIBRATION(Driver1Curr),         // 114 .. 115
+    PARAM_CALIBRATION(Driver2Curr),         // 116 .. 117
+    { 0, PARAM_RESERVED },                  // 118
+    PARAM_RMS(0),                           // 119 .. 121
+    PARAM_RMS(1),                           // 122 .. 124
+    PARAM_RMS(2),                           // 125 .. 127
+    PARAM_RMS(3),                           // 128 .. 130
+    PARAM_CHANNEL_MS(TempJunctionIgbt1),    // 131 .. 134
+    PARAM_CHANNEL_MS(TempJunctionIgbt2),    // 135 .. 138
+    { &TempSlopeWindow_s, PARAM_UINT },     // 139
+    PARAM_CHANNEL_MS(TempSlope[TEMP_SLOPE_PT100_CH1]),  // 140 .. 143
+    PARAM_CHANNEL_MS(TempSlope[TEMP_SLOPE_PT100_CH2]),  // 144 .. 147
+    PARAM_CHANNEL_MS(TempSlope[TEMP_SLOPE_PT100_CH3]),  // 148 .. 151
+    PARAM_CHANNEL_MS(TempSlope[TEMP_SLOPE_PT100_CH4]),  // 152 .. 155
+    PARAM_CHANNEL_MS(TempSlope[TEMP_SLOPE_NTC_IGBT1]),  // 156 .. 159
+    PARAM_CHANNEL_MS(TempSlope[TEMP_SLOPE_NTC_IGBT2]),  // 160 .. 163
+    PARAM_CHANNEL_MS(TempSlope[TEMP_SLOPE_BOARD]),      // 164 .. 167
+    PARAM_CHANNEL_MS(DewPoint),             // 168 .. 171
+    PARAM_PLAUS(0),                         // 172 .. 173
+    PARAM_PLAUS(1),                         // 174 .. 175
+    PARAM_PLAUS(2),                         // 176 .. 177
+    PARAM_PLAUS(3),                         // 178 .. 179
+    PARAM_PLAUS(4),                         // 180 .. 181
+    PARAM_PLAUS(5),                         // 182 .. 183
+    PARAM_PLAUS(6),                         // 184 .. 185
+    PARAM_PLAUS(7)                          // 186 .. 187
+};
+
+#define PARAM_COUNT     (sizeof(param_table) / sizeof(param_table[0]))
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t  staged_index[PARAM_MAX_STAGED];
+static uint32_t staged_value[PARAM_MAX_STAGED];
+static uint8_t  staged_count = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile bool     request_pending = 0;
+static volatile uint8_t  request_cmd = 0;
+static volatile uint8_t  request_index = 0;
+static volatile uint32_t request_value = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Relatorio da calibracao de zero, um quadro por milisegundo
+static uint8_t  report_next = ADC_NUM_CHANNELS;
+static uint32_t report_ms = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static param_status_t param_check(uint8_t index, uint32_t value)
+{
+    union {
+        uint32_t    u32;
+        float       f;
+    } v;
+
+    if(index >= PARAM_COUNT) return PARAM_ERR_INDEX;
+
+    v.u32 = value;
+
+    switch(param_table[index].type)
+    {
+    case PARAM_FLOAT:
+        // Limites sao comparados com +/- valor, devem ser positivos e finitos
+        if(!(v.f >= 0.0 && v.f < 1.0e6)) return PARAM_ERR_RANGE;
+        break;
+
+    case PARAM_UINT:
+        if(value > PARAM_MAX_DELAY) return PARAM_ERR_RANGE;
+        break;
+
+    case PARAM_LONG:
+        if(value > PARAM_MAX_LONG_DELAY) return PARAM_ERR_RANGE;
+        break;
+
+    case PARAM_CODE:
+        if(value > PARAM_MAX_CODE) return PARAM_ERR_RANGE;
+        break;
+
+    case PARAM_FLAG:
+        if(value > 1) return PARAM_ERR_RANGE;
+        break;
+
+    case PARAM_RESERVED:
+        return PARAM_ERR_INDEX;
+    }
+
+    return PARAM_OK;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint8_t ParamCount(void)
+{
+    return PARAM_COUNT;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+param_status_t ParamRead(uint8_t index, uint32_t *value)
+{
+    if(index >= PARAM_COUNT) return PARAM_ERR_INDEX;
+
+    switch(param_table[index].type)
+    {
+    case PARAM_FLOAT:
+        *value = *(uint32_t *)param_table[index].addr;
+        break;
+
+    case PARAM_UINT:
+    case PARAM_LONG:
+    case PARAM_CODE:
+        *value = *(unsigned int *)param_table[index].addr;
+        break;
+
+    case PARAM_FLAG:
+        *value = *(unsigned char *)param_table[index].addr;
+        break;
+
+    case PARAM_RESERVED:
+        return PARAM_ERR_INDEX;
+    }
+
+    return PARAM_OK;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+param_status_t ParamWrite(uint8_t index, uint32_t value)
+{
+    param_status_t status = param_check(index, value);
+
+    if(status != PARAM_OK) return status;
+
+    switch(param_table[index].type)
+    {
+    case PARAM_FLOAT:
+        *(uint32_t *)param_table[index].addr = value;
+        break;
+
+    case PARAM_UINT:
+    case PARAM_LONG:
+    case PARAM_CODE:
+        *(unsigned int *)param_table[index].addr = value;
+        break;
+
+    case PARAM_FLAG:
+        *(unsigned char *)param_table[index].addr = value;
+        break;
+
+    case PARAM_RESERVED:
+        break;
+    }
+
+    return PARAM_OK;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ParamRequest(uint8_t cmd, uint8_t index, uint32_t value)
+{
+    if(request_pending) return 0;
+
+    request_cmd = cmd;
+    request_index = index;
+    request_value = value;
+    request_pending = 1;
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool param_calibration_report(void)
+{
+    unsigned int measured;
+    uint32_t now;
+
+    if(AdcCalibrationDone())
+    {
+        report_next = 0;
+        report_ms = get_millis();
+    }
+
+    if(report_next >= ADC_NUM_CHANNELS) return 0;
+
+    now = get_millis();
+
+    // Relatorio em andamento: requisicoes esperam o ultimo quadro
+    if(now == report_ms || CanHealthTxBusy(MESSAGE_PARAM_IIB_OBJ_ID)) return 1;
+
+    report_ms = now;
+
+    if(AdcCalibrationResult(report_next, &measured))
+    {
+        send_param_message(PARAM_CMD_CALIBRATE, report_next, PARAM_OK, measured);
+    }
+    else send_param_message(PARAM_CMD_CALIBRATE, report_next, PARAM_ERR_RANGE, measured);
+
+    report_next++;
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void ParamService(void)
+{
+    uint8_t i;
+    uint8_t cmd;
+    uint8_t index;
+    uint32_t value;
+    param_status_t status = PARAM_OK;
+
+    // O objeto de TX e compartilhado: a requisicao espera o fim do relatorio
+    if(param_calibration_report()) return;
+
+    if(!request_pending) return;
+
+    // Resposta anterior ainda no objeto de TX: tenta no proximo ciclo
+    if(CanHealthTxBusy(MESSAGE_PARAM_IIB_OBJ_ID)) return;
+
+    cmd = request_cmd;
+    index = request_index;
+    value = request_value;
+
+    request_pending = 0;
+
+    switch(cmd)
+    {
+    case PARAM_CMD_READ:
+        status = ParamRead(index, &value);
+        break;
+
+    case PARAM_CMD_WRITE:
+        status = param_check(index, value);
+
+        if(status == PARAM_OK)
+        {
+            if(staged_count < PARAM_MAX_STAGED)
+            {
+                staged_index[staged_count] = index;
+                staged_value[staged_count] = value;
+                staged_count++;
+            }
+            else status = PARAM_ERR_FULL;
+        }
+        break;
+
+    case PARAM_CMD_APPLY:
+        // Nenhuma interrupcao de protecao ve um conjunto de limites pela metade
+        IntMasterDisable();
+
+        for(i = 0; i < staged_count; i++) ParamWrite(staged_index[i], staged_value[i]);
+
+        IntMasterEnable();
+
+        value = staged_count;
+        staged_count = 0;
+        break;
+
+    case PARAM_CMD_DISCARD:
+        value = staged_count;
+        staged_count = 0;
+        break;
+
+    case PARAM_CMD_COUNT:
+        value = PARAM_COUNT;
+        break;
+
+    case PARAM_CMD_SAVE:
+        // Grava os valores ativos; escritas pendentes nao sao incluidas
+        if(!ConfigSave()) status = PARAM_ERR_STORAGE;
+        value = PARAM_COUNT;
+        break;
+
+    case PARAM_CMD_ERASE:
+        if(!ConfigErase()) status = PARAM_ERR_STORAGE;
+        break;
+
+    case PARAM_CMD_CALIBRATE:
+        // Somente com os reles abertos o zero medido e confiavel
+        if(InterlockRead() && !AdcCalibrationBusy()) AdcCalibrationStart();
+        else status = PARAM_ERR_STATE;
+        break;
+
+#if (AdcInjectEnable == 1)
+
+    case PARAM_CMD_INJECT:
+        if(index == 0xFF) AdcInjectClear();
+        else if(index >= ADC_NUM_CHANNELS) status = PARAM_ERR_INDEX;
+        else if(value == 0xFFFFFFFF) AdcInjectRelease(index);
+        else if((value & 0xFFFF) > PARAM_MAX_CODE || (value >> 16) > PARAM_MAX_CODE) status = PARAM_ERR_RANGE;
+        else if(!AdcInjectSet(index, value & 0xFFFF, value >> 16)) status = PARAM_ERR_STATE;
+        value = AdcInjectTicks();
+        break;
+
+    case PARAM_CMD_INJECT_PERIOD:
+        if(index >= ADC_NUM_CHANNELS) status = PARAM_ERR_INDEX;
+        else if(value > PARAM_MAX_DELAY) status = PARAM_ERR_RANGE;
+        else AdcInjectPeriod(index, value);
+        value = AdcInjectTicks();
+        break;
+
+    case PARAM_CMD_TRIP_LATENCY:
+        if(index >= TRIP_LATENCY_NUM_ITEMS) status = PARAM_ERR_INDEX;
+        else
+        {
+            value = TripLatencyRead((trip_latency_item_t)index);
+
+            switch(TripLatencyState())
+            {
+            case TRIP_LATENCY_PASS:
+                break;
+
+            case TRIP_LATENCY_FAIL:
+            case TRIP_LATENCY_TIMEOUT:
+                status = PARAM_ERR_RANGE;
+                break;
+
+            default:
+                status = PARAM_ERR_STATE;
+                break;
+            }
+        }
+        break;
+
+#endif
+
+    case PARAM_CMD_STACK:
+        if(index > STACK_FREE) status = PARAM_ERR_INDEX;
+        else
+        {
+            value = StackRead((stack_item_t)index);
+            if(StackHeadroomLow()) status = PARAM_ERR_RANGE;
+        }
+        break;
+
+#if (ProfileEnable == 1)
+
+    case PARAM_CMD_PROFILE:
+        if(index == 0xFF) ProfileReset();
+        else if((index & 0x7F) >= PROFILE_NUM_SLOTS) status = PARAM_ERR_INDEX;
+        else
+        {
+            if(index & 0x80) value = ProfileLastRead((profile_slot_t)(index & 0x7F));
+            else value = ProfileMaxRead((profile_slot_t)index);
+
+            if(ProfileOverBudget((profile_slot_t)(index & 0x7F))) status = PARAM_ERR_RANGE;
+        }
+        break;
+
+#endif
+
+    default:
+        status = PARAM_ERR_CMD;
+        break;
+    }
+
+    send_param_message(cmd, index, status, value);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
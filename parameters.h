@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file parameters.h
+ * @brief Runtime parameter service over MESSAGE_PARAM_UDC.
+ *
+ * Limits, debounce delays, interlock enable flags and ADC calibration of the
+ * acquisition channels are read and written by index. Writes are staged and only take
+ * effect on PARAM_CMD_APPLY, all at once, with the protection interrupts
+ * masked.
+ *
+ * Request (MESSAGE_PARAM_UDC) and reply (MESSAGE_PARAM_IIB):
+ * [0] can_address, [1] command, [2] index, [3] status (reply only),
+ * [4..7] value (float for limits and gains, u32 for delays, offsets and flags)
+ *
+ * Index 118 is reserved and answers PARAM_ERR_INDEX.
+ * Indexes 119 + 3 * slot are the adc_rms window in ms, RMS alarm limit and
+ * ripple alarm limit of that slot (0 disables the window or the limit).
+ * Indexes 131..138 are the limits and delays of the estimated IGBT junction
+ * temperatures, in the same layout as the other channels; a limit of 0
+ * disables that check (the FAP trip ships disabled).
+ * Index 139 is the temp_slope window in 1s samples; 140..167 are the dT/dt
+ * limits (degC/min) and delays (updates) of each temp_slope channel, in the
+ * order of temp_slope_channel_t. A limit of 0 disables that check.
+ * Indexes 168..171 are the dew point margin limits (degC, alarm when the
+ * coldest PT100 gets closer than that to the dew point) and delays (updates).
+ * Indexes 172 + 2 * rule are the limit and delay in ms of each plausibility
+ * rule slot, as bound by the module (see plausibility.h). These delays go up
+ * to PARAM_MAX_LONG_DELAY instead of PARAM_MAX_DELAY, so a STUCK rule can wait
+ * for minutes.
+ *
+ * PARAM_CMD_SAVE stores the active values in the internal EEPROM, loaded again
+ * at boot; PARAM_CMD_ERASE makes the next boot use the compiled defaults.
+ * Stored ADC offsets are authoritative: the automatic zero calibration at boot
+ * only runs when no valid image was loaded.
+ *
+ * PARAM_CMD_CALIBRATE re-runs the ADC zero calibration, accepted only while
+ * the module is interlocked. When it finishes, one frame per ADC input is
+ * sent with cmd = PARAM_CMD_CALIBRATE, index = input (adc_0_value[] then
+ * adc_1_value[]), status = PARAM_OK if the offset was applied or
+ * PARAM_ERR_RANGE if rejected or not calibrated, value = measured mean code.
+ *
+ * PARAM_CMD_INJECT / PARAM_CMD_INJECT_PERIOD (only with AdcInjectEnable):
+ * index = ADC input, value = low | (high << 16) codes, or the half period in
+ * ms of the square wave (0 = constant low). INJECT with value 0xFFFFFFFF
+ * releases the input, with index 0xFF releases all of them. Only one input
+ * is injected at a time; INJECT on a second one answers PARAM_ERR_STATE. The
+ * reply value is the number of 1ms samples since the waveform was programmed.
+ *
+ * PARAM_CMD_PROFILE (only with ProfileEnable): index = profile_slot_t, value
+ * = worst cycle count (or the last one with bit 7 of the index set), status
+ * PARAM_ERR_RANGE if the worst count is over the slot budget. Index 0xFF
+ * clears all slots.
+ *
+ * PARAM_CMD_TRIP_LATENCY (only with AdcInjectEnable): index =
+ * trip_latency_item_t, value = item. Status PARAM_OK if both segments of the
+ * last step (step -> trip flag, trip flag -> relays and frame) were within
+ * budget, PARAM_ERR_RANGE if one was not (or a budget ran out), PARAM_ERR_STATE
+ * while no measurement is complete.
+ *
+ * PARAM_CMD_STACK: index = stack_item_t, value = bytes. Status
+ * PARAM_ERR_RANGE when the headroom is below STACK_HEADROOM_MIN.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PARAMETERS_H_
+#define PARAMETERS_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quantidade maxima de escritas pendentes antes do APPLY
+#define PARAM_MAX_STAGED                        16
+
+// Maior atraso aceito, nas unidades do canal (us ou ms)
+#define PARAM_MAX_DELAY                         60000
+
+// Maior atraso longo aceito (regras de plausibilidade), em ms: 1 hora
+#define PARAM_MAX_LONG_DELAY                    3600000
+
+// Maior offset aceito, em codigos do ADC de 12 bits
+#define PARAM_MAX_CODE                          4095
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    PARAM_CMD_READ = 1,
+    PARAM_CMD_WRITE,
+    PARAM_CMD_APPLY,
+    PARAM_CMD_DISCARD,
+    PARAM_CMD_COUNT,
+    PARAM_CMD_SAVE,
+    PARAM_CMD_ERASE,
+    PARAM_CMD_CALIBRATE,
+    PARAM_CMD_INJECT,
+    PARAM_CMD_INJECT_PERIOD,
+    PARAM_CMD_PROFILE,
+    PARAM_CMD_TRIP_LATENCY,
+    PARAM_CMD_STACK
+}param_cmd_t;
+
+typedef enum {
+    PARAM_OK = 0,
+    PARAM_ERR_INDEX,
+    PARAM_ERR_RANGE,
+    PARAM_ERR_FULL,
+    PARAM_ERR_CMD,
+    PARAM_ERR_STORAGE,
+    PARAM_ERR_STATE
+}param_status_t;
+
+typedef enum {
+    PARAM_FLOAT = 0,
+    PARAM_UINT,
+    PARAM_FLAG,
+    PARAM_CODE,
+    PARAM_LONG,
+    PARAM_RESERVED
+}param_type_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern bool ParamRequest(uint8_t cmd, uint8_t index, uint32_t value);
+extern void ParamService(void);
+extern uint8_t ParamCount(void);
+extern param_status_t ParamRead(uint8_t index, uint32_t *value);
+extern param_status_t ParamWrite(uint8_t index, uint32_t value);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* PARAMETERS_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
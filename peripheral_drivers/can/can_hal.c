@@ -0,0 +1,309 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file can_hal.c
+ * @brief Thin access layer to the CAN0 controller.
+ *
+ * Each function maps to one or a few driverlib calls on CAN0_BASE, with no
+ * state of its own. The virtual bus keeps the frames of the RX objects and
+ * the interrupt cause in memory and calls the registered ISR directly.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_can.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/can.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "can_hal.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#if (CanHalVirtualEnable == 1)
+
+typedef struct
+{
+    uint32_t id;
+    uint8_t  len;
+    uint8_t  data[8];
+} can_hal_frame_t;
+
+static void (*virtual_isr)(void) = 0;
+
+static can_hal_tx_hook_t virtual_tx_hook = 0;
+
+static tCANMsgObject *virtual_rx[CAN_HAL_NUM_OBJ];
+
+static can_hal_frame_t virtual_frame[CAN_HAL_NUM_OBJ];
+
+static volatile uint32_t virtual_cause = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Simula a interrupcao do objeto, como o controlador faria
+static void can_hal_virtual_raise(uint8_t obj_id)
+{
+    uint32_t cause = virtual_cause;
+
+    virtual_cause = obj_id;
+
+    if(virtual_isr) virtual_isr();
+
+    virtual_cause = cause;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void CanHalVirtualTxHook(can_hal_tx_hook_t hook)
+{
+    virtual_tx_hook = hook;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CanHalVirtualReceive(uint32_t id, const uint8_t *data, uint8_t len)
+{
+    uint8_t i;
+    uint8_t obj;
+    tCANMsgObject *msg;
+
+    if(len > 8) len = 8;
+
+    for(obj = 0; obj < CAN_HAL_NUM_OBJ; obj++)
+    {
+        msg = virtual_rx[obj];
+
+        if(msg == 0) continue;
+
+        if((id & msg->ui32MsgIDMask) != (msg->ui32MsgID & msg->ui32MsgIDMask)) continue;
+
+        virtual_frame[obj].id = id;
+        virtual_frame[obj].len = len;
+        for(i = 0; i < len; i++) virtual_frame[obj].data[i] = data[i];
+
+        can_hal_virtual_raise(obj + 1);
+
+        return 1;
+    }
+
+    // Nenhum filtro aceitou o ID
+    return 0;
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_hal_init(uint32_t sys_clock, void (*isr)(void))
+{
+#if (CanHalVirtualEnable == 1)
+
+    virtual_isr = isr;
+
+#else
+
+    // Configure the GPIO pin muxing to select CAN0 functions for these pins.
+    GPIOPinConfigure(GPIO_PA0_CAN0RX);
+    GPIOPinConfigure(GPIO_PA1_CAN0TX);
+
+    // Enable the alternate function on the GPIO pins.  The above step selects
+    GPIOPinTypeCAN(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+
+    // Disable CAN0 peripheral
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_CAN0);
+
+    // Reset CAN0 peripheral
+    SysCtlPeripheralReset(SYSCTL_PERIPH_CAN0);
+
+    // Enable CAN0 peripheral
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_CAN0);
+
+    // Wait for the CAN0 module to be ready.
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_CAN0));
+
+    // Disable the CAN0 module.
+    CANDisable(CAN0_BASE);
+
+    // Initialize the CAN controller
+    CANInit(CAN0_BASE);
+
+    // Set up the bit rate for the CAN bus 1Mbps
+    CANBitRateSet(CAN0_BASE, sys_clock, 1000000);
+
+    // Enable interrupts on the CAN peripheral.
+    CANIntEnable(CAN0_BASE, CAN_INT_MASTER | CAN_INT_ERROR | CAN_INT_STATUS);
+
+    CANIntRegister(CAN0_BASE, isr);
+
+    IntPrioritySet(INT_CAN0, 1);
+
+    // Disable auto-retry if no ACK-bit is received by the CAN controller.
+    CANRetrySet(CAN0_BASE, 0);
+
+    // Enable the CAN for operation.
+    CANEnable(CAN0_BASE);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_hal_rx_setup(uint8_t obj_id, tCANMsgObject *msg)
+{
+#if (CanHalVirtualEnable == 1)
+
+    if(obj_id >= 1 && obj_id <= CAN_HAL_NUM_OBJ) virtual_rx[obj_id - 1] = msg;
+
+#else
+
+    CANMessageSet(CAN0_BASE, obj_id, msg, MSG_OBJ_TYPE_RX);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_hal_tx(uint8_t obj_id, tCANMsgObject *msg)
+{
+#if (CanHalVirtualEnable == 1)
+
+    if(virtual_tx_hook) virtual_tx_hook(msg->ui32MsgID, msg->pui8MsgData, msg->ui32MsgLen);
+
+    // O barramento virtual confirma o quadro na hora
+    can_hal_virtual_raise(obj_id);
+
+#else
+
+    CANMessageSet(CAN0_BASE, obj_id, msg, MSG_OBJ_TYPE_TX);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_hal_message_get(uint8_t obj_id, tCANMsgObject *msg)
+{
+#if (CanHalVirtualEnable == 1)
+
+    uint8_t i;
+    can_hal_frame_t *frame;
+
+    if(obj_id < 1 || obj_id > CAN_HAL_NUM_OBJ) return;
+
+    frame = &virtual_frame[obj_id - 1];
+
+    msg->ui32MsgID = frame->id;
+    msg->ui32MsgLen = frame->len;
+    for(i = 0; i < frame->len; i++) msg->pui8MsgData[i] = frame->data[i];
+
+#else
+
+    CANMessageGet(CAN0_BASE, obj_id, msg, 0);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t can_hal_int_cause(void)
+{
+#if (CanHalVirtualEnable == 1)
+
+    return virtual_cause;
+
+#else
+
+    return CANIntStatus(CAN0_BASE, CAN_INT_STS_CAUSE);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_hal_int_clear(uint8_t obj_id)
+{
+#if (CanHalVirtualEnable == 0)
+
+    CANIntClear(CAN0_BASE, obj_id);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Le (e limpa) o registrador de status do controlador
+uint32_t can_hal_status(void)
+{
+#if (CanHalVirtualEnable == 1)
+
+    return CAN_STATUS_LEC_NONE;
+
+#else
+
+    return CANStatusGet(CAN0_BASE, CAN_STS_CONTROL);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Bit (obj_id - 1) ligado: o objeto ainda aguarda o barramento
+uint32_t can_hal_tx_requests(void)
+{
+#if (CanHalVirtualEnable == 1)
+
+    return 0;
+
+#else
+
+    return CANStatusGet(CAN0_BASE, CAN_STS_TXREQUEST);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void can_hal_error_counters(uint32_t *rx_count, uint32_t *tx_count)
+{
+#if (CanHalVirtualEnable == 1)
+
+    *rx_count = 0;
+    *tx_count = 0;
+
+#else
+
+    CANErrCntrGet(CAN0_BASE, rx_count, tx_count);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Limpa o INIT apos bus-off
+void can_hal_enable(void)
+{
+#if (CanHalVirtualEnable == 0)
+
+    CANEnable(CAN0_BASE);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
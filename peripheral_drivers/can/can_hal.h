@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file can_hal.h
+ * @brief Thin access layer to the CAN0 controller.
+ *
+ * can_bus.c and can_health.c reach the controller only through these
+ * functions. With CanHalVirtualEnable set to 1 the controller is replaced by
+ * an in-memory bus: every transmitted frame goes to the hook given to
+ * CanHalVirtualTxHook() and completes at once, and CanHalVirtualReceive()
+ * delivers a frame to the RX object whose filter accepts its ID. In both
+ * cases the frame goes through can_isr(), as on the real controller. The
+ * virtual bus does not model arbitration, error counters or bus-off.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DRIVERS_PERIPHERAL_DRIVERS_CAN_CAN_HAL_H_
+#define DRIVERS_PERIPHERAL_DRIVERS_CAN_CAN_HAL_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/can.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1: barramento virtual em memoria no lugar do controlador (testes fora da placa)
+#define CanHalVirtualEnable                     0
+
+// Objetos de mensagem do controlador (IDs 1 a CAN_HAL_NUM_OBJ)
+#define CAN_HAL_NUM_OBJ                         32
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void can_hal_init(uint32_t sys_clock, void (*isr)(void));
+extern void can_hal_rx_setup(uint8_t obj_id, tCANMsgObject *msg);
+extern void can_hal_tx(uint8_t obj_id, tCANMsgObject *msg);
+extern void can_hal_message_get(uint8_t obj_id, tCANMsgObject *msg);
+extern uint32_t can_hal_int_cause(void);
+extern void can_hal_int_clear(uint8_t obj_id);
+extern uint32_t can_hal_status(void);
+extern uint32_t can_hal_tx_requests(void);
+extern void can_hal_error_counters(uint32_t *rx_count, uint32_t *tx_count);
+extern void can_hal_enable(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#if (CanHalVirtualEnable == 1)
+
+typedef void (*can_hal_tx_hook_t)(uint32_t id, const uint8_t *data, uint8_t len);
+
+extern void CanHalVirtualTxHook(can_hal_tx_hook_t hook);
+extern bool CanHalVirtualReceive(uint32_t id, const uint8_t *data, uint8_t len);
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* DRIVERS_PERIPHERAL_DRIVERS_CAN_CAN_HAL_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +38,7 @@
 #include "board_drivers/hardware_def.h"
 #include "peripheral_drivers/gpio/gpio_driver.h"
 #include "peripheral_drivers/timer/timer.h"
+#include "profile.h"
 #include "leds.h"
 #include "output.h"
 #include "input.h"
@@ -76,6 +77,20 @@ void delay_ms(uint32_t time)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+uint32_t get_micros(void)
+{
+    return micros;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t get_millis(void)
+{
+    return millis;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 void IntTimer1usHandler(void)
 {
 	// Clear the timer 2 interrupt.
@@ -93,8 +108,12 @@ void IntTimer100usHandler(void)
 
     RunToggle();
 
+    PROFILE_START(PROFILE_TASK_100US);
+
     task_100_us();
 
+    PROFILE_STOP(PROFILE_TASK_100US);
+
     RunToggle();
 }
 
@@ -107,6 +126,8 @@ void IntTimer1msHandler(void)
 
     millis++;
 
+    PROFILE_START(PROFILE_TASK_1MS);
+
     RunToggle();
 
     sample_adc();
@@ -114,6 +135,8 @@ void IntTimer1msHandler(void)
     RunToggle();
 
     task_1_ms();
+
+    PROFILE_STOP(PROFILE_TASK_1MS);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -122,15 +145,6 @@ void IntTimer100msHandler(void)
 {
     // Clear the timer 3 interrupt.
     TimerIntClear(TIMER3_BASE, TIMER_TIMA_TIMEOUT);
-
-    // Usado para testes com leituras rapidas.
-
-#if (Fast_CAN == 1)
-
-    send_data_schedule();
-
-#endif
-
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,8 @@
 
 extern void delay_us(uint32_t time);
 extern void delay_ms(uint32_t time);
+extern uint32_t get_micros(void);
+extern uint32_t get_millis(void);
 extern void IntTimer1usHandler(void);
 extern void IntTimer100usHandler(void);
 extern void IntTimer1msHandler(void);
@@ -0,0 +1,184 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file plausibility.c
+ * @brief Cross-channel plausibility rules between redundant measurements.
+ *
+ * PlausibilitySample() runs in the 1ms interrupt and evaluates every rule
+ * once on the latest channel values, keeping only a delay counter per rule.
+ * A dead sensor usually reads a steady in-range value (a Hall at 0 A, a
+ * PT100 whose converter stopped answering), so it is caught by comparing it
+ * with its redundant partner or by the lack of any change in the reading.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "plausibility.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+plausibility_rule_t PlausibilityRule[PLAUSIBILITY_MAX_RULES];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static float plausibility_abs(float x)
+{
+    return (x < 0.0) ? -x : x;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void PlausibilityRuleInit(uint8_t rule, plausibility_type_t type,
+                          const float *a, const float *b,
+                          float limit, float floor, unsigned int delay_ms)
+{
+    plausibility_rule_t *r;
+
+    if(rule >= PLAUSIBILITY_MAX_RULES) return;
+
+    r = &PlausibilityRule[rule];
+
+    // Regra parada enquanto os ponteiros sao trocados
+    r->Type = PLAUSIBILITY_NONE;
+
+    r->A = a;
+    r->B = b;
+    r->Limit = limit;
+    r->Floor = floor;
+    r->Value = 0.0;
+    r->Last = *a;
+    r->Alarm = 0;
+    r->Alarm_Delay_ms = delay_ms;
+    r->Alarm_DelayCount = 0;
+    r->Valid = 0;
+
+    if(type != PLAUSIBILITY_STUCK && b == 0) return;
+
+    r->Type = type;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void PlausibilityRuleValid(uint8_t rule, unsigned char (*valid)(void))
+{
+    if(rule >= PLAUSIBILITY_MAX_RULES) return;
+
+    PlausibilityRule[rule].Valid = valid;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void PlausibilitySample(void)
+{
+    plausibility_rule_t *r;
+    float a;
+    float b;
+    float big;
+    uint8_t n;
+
+    for(n = 0; n < PLAUSIBILITY_MAX_RULES; n++)
+    {
+        r = &PlausibilityRule[n];
+
+        if(r->Type == PLAUSIBILITY_NONE) continue;
+
+        a = *r->A;
+
+        // Fonte sem leitura atual: regra em repouso, STUCK recomeca do valor de agora
+        if(r->Valid && !r->Valid())
+        {
+            r->Last = a;
+            r->Value = 0.0;
+            r->Alarm_DelayCount = 0;
+            continue;
+        }
+
+        if(r->Type == PLAUSIBILITY_STUCK)
+        {
+            if(r->Alarm_Delay_ms == 0) continue;
+
+            if(a != r->Last)
+            {
+                r->Last = a;
+                r->Alarm_DelayCount = 0;
+            }
+            else if(r->Alarm_DelayCount < r->Alarm_Delay_ms) r->Alarm_DelayCount++;
+            else r->Alarm = 1;
+
+            r->Value = r->Alarm_DelayCount;
+
+            continue;
+        }
+
+        b = *r->B;
+
+        big = plausibility_abs(a);
+        if(plausibility_abs(b) > big) big = plausibility_abs(b);
+
+        if(r->Limit <= 0.0 || big < r->Floor)
+        {
+            r->Value = 0.0;
+            r->Alarm_DelayCount = 0;
+            continue;
+        }
+
+        if(r->Type == PLAUSIBILITY_IMBALANCE) r->Value = plausibility_abs(a - b) * 100.0 / big;
+        else r->Value = a - b;
+
+        if(r->Value > r->Limit)
+        {
+            if(r->Alarm_DelayCount < r->Alarm_Delay_ms) r->Alarm_DelayCount++;
+            else
+            {
+               r->Alarm_DelayCount = 0;
+               r->Alarm = 1;
+            }
+        }
+        else r->Alarm_DelayCount = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float PlausibilityRead(uint8_t rule)
+{
+    if(rule >= PLAUSIBILITY_MAX_RULES) return 0.0;
+
+    return PlausibilityRule[rule].Value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char PlausibilityAlarmStatusRead(uint8_t rule)
+{
+    if(rule >= PLAUSIBILITY_MAX_RULES) return 0;
+
+    return PlausibilityRule[rule].Alarm;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void PlausibilityClearAlarm(void)
+{
+    uint8_t n;
+
+    for(n = 0; n < PLAUSIBILITY_MAX_RULES; n++)
+    {
+        PlausibilityRule[n].Alarm = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
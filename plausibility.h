@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file plausibility.h
+ * @brief Cross-channel plausibility rules between redundant measurements.
+ *
+ * A module binds each rule slot to the Value of one or two channels:
+ *
+ *   IMBALANCE: |A - B| > Limit % of max(|A|, |B|)
+ *   GREATER:   A > B + Limit
+ *   STUCK:     A holds exactly the same value for Alarm_Delay_ms
+ *
+ * IMBALANCE and GREATER are skipped while both |A| and |B| are below Floor,
+ * and fire after Alarm_Delay_ms; a Limit of 0 disables them. STUCK is
+ * disabled with a delay of 0. The alarms stay latched until the clear.
+ *
+ * PlausibilityRuleValid() gates a rule on the state of its sources: while the
+ * function returns 0 the rule is held at rest, so a sensor that keeps its last
+ * reading while degraded is not reported as stuck.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLAUSIBILITY_H_
+#define PLAUSIBILITY_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PlausibilityEnable                      1
+
+#define PLAUSIBILITY_MAX_RULES                  8
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    PLAUSIBILITY_NONE = 0,
+    PLAUSIBILITY_IMBALANCE,
+    PLAUSIBILITY_GREATER,
+    PLAUSIBILITY_STUCK
+}plausibility_type_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    plausibility_type_t Type;
+    const float *A;
+    const float *B;
+    float Limit;                  // % (IMBALANCE) ou unidade do canal (GREATER)
+    float Floor;
+    float Value;                  // desvio atual; ms sem variacao para STUCK
+    float Last;
+    unsigned char Alarm;
+    unsigned int  Alarm_Delay_ms; // milisecond
+    unsigned int  Alarm_DelayCount;
+    unsigned char (*Valid)(void); // 0 ou !0: fontes utilizaveis nesta amostra
+}plausibility_rule_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern plausibility_rule_t PlausibilityRule[PLAUSIBILITY_MAX_RULES];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void PlausibilityRuleInit(uint8_t rule, plausibility_type_t type,
+                                 const float *a, const float *b,
+                                 float limit, float floor, unsigned int delay_ms);
+extern void PlausibilityRuleValid(uint8_t rule, unsigned char (*valid)(void));
+extern void PlausibilitySample(void);
+extern float PlausibilityRead(uint8_t rule);
+extern unsigned char PlausibilityAlarmStatusRead(uint8_t rule);
+extern void PlausibilityClearAlarm(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* PLAUSIBILITY_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
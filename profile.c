@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file profile.c
+ * @brief Cycle counting of the interrupt tasks and conversion kernels.
+ *
+ * Each slot has a single start register, so a slot must not be nested or
+ * used from two interrupt levels.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "profile.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define DWT_CTRL                (*(volatile uint32_t *)0xE0001000)
+#define DEMCR                   (*(volatile uint32_t *)0xE000EDFC)
+
+#define DWT_CTRL_CYCCNTENA      0x00000001
+#define DEMCR_TRCENA            0x01000000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Orcamento de ciclos por slot (120MHz). Acima disso o slot e sinalizado.
+static const uint32_t profile_budget[PROFILE_NUM_SLOTS] =
+{
+    6000,       // PROFILE_TASK_100US     50us, metade do periodo
+    60000,      // PROFILE_TASK_1MS       500us
+    600,        // PROFILE_CURRENT_SAMPLE 5us
+    120000,     // PROFILE_PT100_TEMP     1ms, dominado pelo SPI
+    6000,       // PROFILE_NTC_TEMP       50us
+    1200,       // PROFILE_RH_LINEARIZE   10us
+    12000       // PROFILE_ITLK_CHECK     100us
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t profile_start[PROFILE_NUM_SLOTS];
+
+static volatile uint32_t profile_last[PROFILE_NUM_SLOTS];
+static volatile uint32_t profile_max[PROFILE_NUM_SLOTS];
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void ProfileInit(void)
+{
+    DEMCR |= DEMCR_TRCENA;
+
+    PROFILE_CYCCNT = 0;
+
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    ProfileReset();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void ProfileRecord(profile_slot_t slot, uint32_t cycles)
+{
+    profile_last[slot] = cycles;
+
+    if(cycles > profile_max[slot]) profile_max[slot] = cycles;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void ProfileReset(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < PROFILE_NUM_SLOTS; i++)
+    {
+        profile_last[i] = 0;
+        profile_max[i] = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t ProfileMaxRead(profile_slot_t slot)
+{
+    return profile_max[slot];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t ProfileLastRead(profile_slot_t slot)
+{
+    return profile_last[slot];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ProfileOverBudget(profile_slot_t slot)
+{
+    return (profile_max[slot] > profile_budget[slot]);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file profile.h
+ * @brief Cycle counting of the interrupt tasks and conversion kernels.
+ *
+ * PROFILE_START()/PROFILE_STOP() read the Cortex-M4 DWT cycle counter around
+ * a section and keep the last and the worst count of each slot. The worst
+ * count is compared with a per-slot cycle budget, so a regression in a hot
+ * path shows up on a rack board without a debugger attached.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define ProfileEnable                           1
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// DWT CYCCNT: ciclos de 120MHz desde ProfileInit()
+#define PROFILE_CYCCNT                          (*(volatile uint32_t *)0xE0001004)
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    PROFILE_TASK_100US = 0,     // task_100_us() inteira
+    PROFILE_TASK_1MS,           // sample_adc() e task_1_ms()
+    PROFILE_CURRENT_SAMPLE,     // CurrentCh1Sample()
+    PROFILE_PT100_TEMP,         // get_Temp(), inclui a leitura SPI
+    PROFILE_NTC_TEMP,           // GetTemperatureIgbt1()
+    PROFILE_RH_LINEARIZE,       // linearizacao do Si7005 em RelativeHumidityRead()
+    PROFILE_ITLK_CHECK,         // check_*_interlocks()
+    PROFILE_NUM_SLOTS
+}profile_slot_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#if (ProfileEnable == 1)
+
+extern uint32_t profile_start[PROFILE_NUM_SLOTS];
+
+#define PROFILE_START(slot)     (profile_start[slot] = PROFILE_CYCCNT)
+#define PROFILE_STOP(slot)      ProfileRecord(slot, PROFILE_CYCCNT - profile_start[slot])
+
+#else
+
+#define PROFILE_START(slot)
+#define PROFILE_STOP(slot)
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ProfileInit(void);
+extern void ProfileRecord(profile_slot_t slot, uint32_t cycles);
+extern void ProfileReset(void);
+extern uint32_t ProfileMaxRead(profile_slot_t slot);
+extern uint32_t ProfileLastRead(profile_slot_t slot);
+extern bool ProfileOverBudget(profile_slot_t slot);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* PROFILE_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,7 @@
 #include "peripheral_drivers/timer/timer.h"
 #include "pt100.h"
 #include "leds.h"
+#include "profile.h"
 
 #include <iib_modules/fap.h>
 #include <iib_modules/fac_os.h>
@@ -123,15 +124,15 @@ void get_Temp(pt100_t *pt100)
 		if(TempT < 0.0) TempT = 0.0;
 
 		else if(TempT > 255.0) TempT = 255.0;
+
+		pt100->Temperature = TempT;
 	}
 	else
 	{
 		// "Error was detected. The RTD resistance measured is not within the range specified in the Threshold Registers."
+		// Mantem a ultima leitura valida, a falha e sinalizada pela supervisao
 		pt100->RtdOutOfRange = 1;
-		TempT = 0.0;
 	}
-
-	pt100->Temperature = TempT;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -234,6 +235,9 @@ void Pt100ReadChannel(pt100_t *pt100)
 {
 	unsigned int Fault_Error = 0; // Variable to read Fault register and compute faults
 
+	// Canal falho fica fora do barramento SPI ate a proxima tentativa
+	if(pt100->Health == PT100_HEALTH_FAULTED) return;
+
 	// Set mux channel
 	Pt100Channel(pt100);
 
@@ -244,8 +248,12 @@ void Pt100ReadChannel(pt100_t *pt100)
 	if(Fault_Error == 0)
 	{
 		// Calling get_Temp() to read RTD registers and convert to Temperature reading
+		PROFILE_START(PROFILE_PT100_TEMP);
+
 		get_Temp(pt100);
 
+		PROFILE_STOP(PROFILE_PT100_TEMP);
+
 		pt100->Error = Fault_Error;
 
 		if(pt100->Temperature > pt100->AlarmLimit)
@@ -274,9 +282,7 @@ void Pt100ReadChannel(pt100_t *pt100)
 	}
 	else
 	{
-		// Save the error
-		pt100->Temperature = 0.0;
-
+		// Save the error, keeping the last valid temperature
 		pt100->Error = Fault_Error;
 	}
 }
@@ -294,6 +300,126 @@ void Pt100ChannelClear(pt100_t *pt100)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+pt100_fault_t Pt100FaultDecode(pt100_t *pt100)
+{
+	// Barramento sem resposta le o registrador com todos os bits em 1
+	if(pt100->CanNotCommunicate || pt100->Error == 0xFF) return PT100_FAULT_NO_COMMUNICATION;
+
+	if(pt100->Error & PT100_FAULT_REG_OVUV) return PT100_FAULT_OVERVOLTAGE;
+
+	if(pt100->Error & PT100_FAULT_REG_RTD_LOW) return PT100_FAULT_SHORT;
+
+	// RTD high, REFIN, RTDIN ou codigo fora da faixa
+	return PT100_FAULT_OPEN;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void Pt100HealthFault(pt100_t *pt100)
+{
+	unsigned int delay = PT100_RETRY_MAX_S;
+
+	// Backoff exponencial: cada tentativa sem sucesso dobra a espera
+	if((PT100_RETRY_MIN_S << pt100->RetryCount) < PT100_RETRY_MAX_S)
+	{
+		delay = PT100_RETRY_MIN_S << pt100->RetryCount;
+		pt100->RetryCount++;
+	}
+
+	pt100->RetryTimer_s = delay;
+	pt100->StateCount = 0;
+	pt100->GoodCount = 0;
+	pt100->Health = PT100_HEALTH_FAULTED;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Chamada a cada 1s, apos as leituras do ciclo
+void Pt100HealthChannel(pt100_t *pt100)
+{
+	unsigned char bad = pt100->CanNotCommunicate || pt100->Error || pt100->RtdOutOfRange;
+
+	if(bad && pt100->Health != PT100_HEALTH_FAULTED) pt100->Fault = Pt100FaultDecode(pt100);
+
+	switch(pt100->Health)
+	{
+	case PT100_HEALTH_OK:
+
+		if(bad)
+		{
+			pt100->StateCount = 1;
+			pt100->GoodCount = 0;
+			pt100->Health = PT100_HEALTH_DEGRADED;
+
+			Pt100ChannelClear(pt100);
+		}
+
+		break;
+
+	case PT100_HEALTH_DEGRADED:
+
+		// Contador com memoria: uma leitura boa nao zera as falhas, so
+		// PT100_RECOVERY_COUNT leituras boas seguidas; falhas alternadas acumulam
+		if(!bad)
+		{
+			if(++pt100->GoodCount >= PT100_RECOVERY_COUNT)
+			{
+				pt100->StateCount = 0;
+				pt100->GoodCount = 0;
+				pt100->Health = PT100_HEALTH_OK;
+			}
+		}
+		else
+		{
+			pt100->GoodCount = 0;
+
+			if(++pt100->StateCount >= PT100_FAULT_COUNT) Pt100HealthFault(pt100);
+
+			else Pt100ChannelClear(pt100);
+		}
+
+		break;
+
+	case PT100_HEALTH_FAULTED:
+
+		if(pt100->RetryTimer_s > 0) pt100->RetryTimer_s--;
+
+		if(pt100->RetryTimer_s == 0)
+		{
+			// Reinicializa o MAX31865 e volta a amostrar o canal
+			Pt100InitChannel(pt100);
+
+			pt100->GoodCount = 0;
+			pt100->Health = PT100_HEALTH_RECOVERING;
+		}
+
+		break;
+
+	case PT100_HEALTH_RECOVERING:
+
+		if(bad) Pt100HealthFault(pt100);
+
+		else if(++pt100->GoodCount >= PT100_RECOVERY_COUNT)
+		{
+			pt100->StateCount = 0;
+			pt100->GoodCount = 0;
+			pt100->RetryCount = 0;
+			pt100->Fault = PT100_FAULT_NONE;
+			pt100->Health = PT100_HEALTH_OK;
+		}
+
+		break;
+
+	default:
+
+		break;
+	}
+
+	if(pt100->Health == PT100_HEALTH_FAULTED || pt100->Health == PT100_HEALTH_RECOVERING) pt100->Failure = 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 void Pt100Init(void)
 {
 	set_gpio_as_input(RTD_DRDY_1_BASE, RTD_DRDY_1_PIN);
@@ -325,6 +451,13 @@ void Pt100Init(void)
     Pt100Ch1.Alarm_DelayCount   = 0;
     Pt100Ch1.Itlk_Delay_ms      = 0;
     Pt100Ch1.Itlk_DelayCount    = 0;
+    Pt100Ch1.Health             = PT100_HEALTH_OK;
+    Pt100Ch1.Fault              = PT100_FAULT_NONE;
+    Pt100Ch1.Failure            = 0;
+    Pt100Ch1.StateCount         = 0;
+    Pt100Ch1.GoodCount          = 0;
+    Pt100Ch1.RetryCount         = 0;
+    Pt100Ch1.RetryTimer_s       = 0;
 
 #if (Pt100Ch1Enable == 1)
 
@@ -347,6 +480,13 @@ void Pt100Init(void)
     Pt100Ch2.Alarm_DelayCount   = 0;
     Pt100Ch2.Itlk_Delay_ms      = 0;
     Pt100Ch2.Itlk_DelayCount    = 0;
+    Pt100Ch2.Health             = PT100_HEALTH_OK;
+    Pt100Ch2.Fault              = PT100_FAULT_NONE;
+    Pt100Ch2.Failure            = 0;
+    Pt100Ch2.StateCount         = 0;
+    Pt100Ch2.GoodCount          = 0;
+    Pt100Ch2.RetryCount         = 0;
+    Pt100Ch2.RetryTimer_s       = 0;
 
 #if (Pt100Ch2Enable == 1)
 
@@ -369,6 +509,13 @@ void Pt100Init(void)
     Pt100Ch3.Alarm_DelayCount   = 0;
     Pt100Ch3.Itlk_Delay_ms      = 0;
     Pt100Ch3.Itlk_DelayCount    = 0;
+    Pt100Ch3.Health             = PT100_HEALTH_OK;
+    Pt100Ch3.Fault              = PT100_FAULT_NONE;
+    Pt100Ch3.Failure            = 0;
+    Pt100Ch3.StateCount         = 0;
+    Pt100Ch3.GoodCount          = 0;
+    Pt100Ch3.RetryCount         = 0;
+    Pt100Ch3.RetryTimer_s       = 0;
 
 #if (Pt100Ch3Enable == 1)
 
@@ -391,6 +538,13 @@ void Pt100Init(void)
     Pt100Ch4.Alarm_DelayCount   = 0;
     Pt100Ch4.Itlk_Delay_ms      = 0;
     Pt100Ch4.Itlk_DelayCount    = 0;
+    Pt100Ch4.Health             = PT100_HEALTH_OK;
+    Pt100Ch4.Fault              = PT100_FAULT_NONE;
+    Pt100Ch4.Failure            = 0;
+    Pt100Ch4.StateCount         = 0;
+    Pt100Ch4.GoodCount          = 0;
+    Pt100Ch4.RetryCount         = 0;
+    Pt100Ch4.RetryTimer_s       = 0;
 
 #if (Pt100Ch4Enable == 1)
 
@@ -621,6 +775,12 @@ void Pt100ClearAlarmTrip(void)
 	Pt100Ch4.Alarm = 0;
 	Pt100Ch4.Trip  = 0;
 
+	// Volta a ser sinalizado no proximo ciclo se o sensor continuar falho
+	Pt100Ch1.Failure = 0;
+	Pt100Ch2.Failure = 0;
+	Pt100Ch3.Failure = 0;
+	Pt100Ch4.Failure = 0;
+
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -1000,5 +1160,227 @@ void Pt100Ch4Reset(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+// Supervision of the PT100 channels, once per second
+void Pt100HealthCheck(void)
+{
+#if (Pt100Ch1Enable == 1)
+
+    Pt100HealthChannel(&Pt100Ch1);
+
+#endif
+
+#if (Pt100Ch2Enable == 1)
+
+    Pt100HealthChannel(&Pt100Ch2);
+
+#endif
+
+#if (Pt100Ch3Enable == 1)
+
+    Pt100HealthChannel(&Pt100Ch3);
+
+#endif
+
+#if (Pt100Ch4Enable == 1)
+
+    Pt100HealthChannel(&Pt100Ch4);
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 1 health state
+unsigned char Pt100Ch1HealthRead(void)
+{
+#if (Pt100Ch1Enable == 1)
+
+    return Pt100Ch1.Health;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 2 health state
+unsigned char Pt100Ch2HealthRead(void)
+{
+#if (Pt100Ch2Enable == 1)
+
+    return Pt100Ch2.Health;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 3 health state
+unsigned char Pt100Ch3HealthRead(void)
+{
+#if (Pt100Ch3Enable == 1)
+
+    return Pt100Ch3.Health;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 4 health state
+unsigned char Pt100Ch4HealthRead(void)
+{
+#if (Pt100Ch4Enable == 1)
+
+    return Pt100Ch4.Health;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 1 decoded fault
+unsigned char Pt100Ch1FaultRead(void)
+{
+#if (Pt100Ch1Enable == 1)
+
+    return Pt100Ch1.Fault;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 2 decoded fault
+unsigned char Pt100Ch2FaultRead(void)
+{
+#if (Pt100Ch2Enable == 1)
+
+    return Pt100Ch2.Fault;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 3 decoded fault
+unsigned char Pt100Ch3FaultRead(void)
+{
+#if (Pt100Ch3Enable == 1)
+
+    return Pt100Ch3.Fault;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 4 decoded fault
+unsigned char Pt100Ch4FaultRead(void)
+{
+#if (Pt100Ch4Enable == 1)
+
+    return Pt100Ch4.Fault;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 1 sensor failure flag
+unsigned char Pt100Ch1FailureRead(void)
+{
+#if (Pt100Ch1Enable == 1)
+
+    return Pt100Ch1.Failure;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 2 sensor failure flag
+unsigned char Pt100Ch2FailureRead(void)
+{
+#if (Pt100Ch2Enable == 1)
+
+    return Pt100Ch2.Failure;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 3 sensor failure flag
+unsigned char Pt100Ch3FailureRead(void)
+{
+#if (Pt100Ch3Enable == 1)
+
+    return Pt100Ch3.Failure;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read Channel 4 sensor failure flag
+unsigned char Pt100Ch4FailureRead(void)
+{
+#if (Pt100Ch4Enable == 1)
+
+    return Pt100Ch4.Failure;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 
 
@@ -6,6 +6,42 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+// Bits do registrador de falha do MAX31865 (0x07)
+#define PT100_FAULT_REG_RTD_HIGH                0x80
+#define PT100_FAULT_REG_RTD_LOW                 0x40
+#define PT100_FAULT_REG_REFIN_HIGH              0x20
+#define PT100_FAULT_REG_REFIN_LOW               0x10
+#define PT100_FAULT_REG_RTDIN_LOW               0x08
+#define PT100_FAULT_REG_OVUV                    0x04
+
+// Supervisao: falhas acumuladas ate FAULTED, leituras boas seguidas para
+// voltar a OK; so elas zeram o contador, entao falhas intermitentes acumulam
+#define PT100_FAULT_COUNT                       3
+#define PT100_RECOVERY_COUNT                    5
+
+// Backoff das tentativas de reinicializacao, em segundos: MIN << n ate MAX
+#define PT100_RETRY_MIN_S                       2
+#define PT100_RETRY_MAX_S                       256
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    PT100_HEALTH_OK = 0,
+    PT100_HEALTH_DEGRADED,          // falha isolada, mantem a ultima leitura valida
+    PT100_HEALTH_FAULTED,           // fora do barramento SPI ate a proxima tentativa
+    PT100_HEALTH_RECOVERING         // reinicializado, aguardando leituras boas
+}pt100_health_t;
+
+typedef enum {
+    PT100_FAULT_NONE = 0,
+    PT100_FAULT_NO_COMMUNICATION,
+    PT100_FAULT_OPEN,               // RTD ou cabo aberto (RTD high / REFIN / RTDIN)
+    PT100_FAULT_SHORT,              // RTD em curto (RTD low)
+    PT100_FAULT_OVERVOLTAGE         // sobre/subtensao nas entradas
+}pt100_fault_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 typedef struct
 {
     unsigned char Ch;
@@ -22,6 +58,13 @@ typedef struct
     unsigned int  Alarm_DelayCount;
     unsigned int  Itlk_Delay_ms; // milisecond
     unsigned int  Itlk_DelayCount;
+    unsigned char Health;           // pt100_health_t
+    unsigned char Fault;            // pt100_fault_t da ultima falha
+    unsigned char Failure;          // sensor falho, travado ate o clear
+    unsigned char StateCount;       // falhas acumuladas (DEGRADED)
+    unsigned char GoodCount;        // leituras boas seguidas (DEGRADED e RECOVERING)
+    unsigned char RetryCount;
+    unsigned int  RetryTimer_s;
 }pt100_t;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -124,6 +167,31 @@ extern void Pt100Ch4Reset(void);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+extern void Pt100HealthCheck(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern unsigned char Pt100Ch1HealthRead(void);
+extern unsigned char Pt100Ch2HealthRead(void);
+extern unsigned char Pt100Ch3HealthRead(void);
+extern unsigned char Pt100Ch4HealthRead(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern unsigned char Pt100Ch1FaultRead(void);
+extern unsigned char Pt100Ch2FaultRead(void);
+extern unsigned char Pt100Ch3FaultRead(void);
+extern unsigned char Pt100Ch4FaultRead(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern unsigned char Pt100Ch1FailureRead(void);
+extern unsigned char Pt100Ch2FailureRead(void);
+extern unsigned char Pt100Ch3FailureRead(void);
+extern unsigned char Pt100Ch4FailureRead(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 extern void Pt100ClearAlarmTrip(void);
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file stack_monitor.c
+ * @brief Stack high-water mark by painting.
+ *
+ * The stack grows down from __STACK_TOP to __stack (tm4c129encpdt.cmd).
+ * StackPaint() must be the first call in main(), before any interrupt is
+ * enabled; it stops a few words below its own frame.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "stack_monitor.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Simbolos do linker: base da secao .stack e topo inicial da pilha
+extern uint32_t __stack;
+extern uint32_t __STACK_TOP;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Palavras abaixo do quadro atual deixadas sem pintar
+#define STACK_PAINT_GUARD       16
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void StackPaint(void)
+{
+    volatile uint32_t here = 0;
+    uint32_t *word = &__stack;
+    uint32_t *limit = (uint32_t *)&here - STACK_PAINT_GUARD;
+
+    while(word < limit) *word++ = STACK_PAINT_PATTERN;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t stack_used(void)
+{
+    const uint32_t *word = &__stack;
+    const uint32_t *top = &__STACK_TOP;
+
+    while(word < top && *word == STACK_PAINT_PATTERN) word++;
+
+    return (uint32_t)(top - word) * sizeof(uint32_t);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t StackRead(stack_item_t item)
+{
+    uint32_t size = (uint32_t)(&__STACK_TOP - &__stack) * sizeof(uint32_t);
+
+    switch(item)
+    {
+    case STACK_USED:
+        return stack_used();
+
+    case STACK_SIZE:
+        return size;
+
+    case STACK_FREE:
+        return size - stack_used();
+
+    default:
+        return 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+bool StackHeadroomLow(void)
+{
+    return (StackRead(STACK_FREE) < STACK_HEADROOM_MIN);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file stack_monitor.h
+ * @brief Stack high-water mark by painting.
+ *
+ * StackPaint() fills the unused part of the .stack section with a pattern at
+ * boot. The deepest main loop call chain with every interrupt level nested on
+ * top of it overwrites the pattern, so the first intact word from the bottom
+ * gives the worst stack use since reset.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STACK_MONITOR_H_
+#define STACK_MONITOR_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define STACK_PAINT_PATTERN                     0xA5A5A5A5
+
+// Folga minima aceitavel entre o pior uso e o fim da pilha, em bytes
+#define STACK_HEADROOM_MIN                      64
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    STACK_USED = 0,             // maior uso desde o reset, bytes
+    STACK_SIZE,                 // tamanho da secao .stack, bytes
+    STACK_FREE                  // folga restante, bytes
+}stack_item_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void StackPaint(void);
+extern uint32_t StackRead(stack_item_t item);
+extern bool StackHeadroomLow(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* STACK_MONITOR_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +36,18 @@
 #include "pt100.h"
 #include "ntc_isolated_i2c.h"
 #include "application.h"
+#include "telemetry.h"
+#include "capture.h"
+#include "profile.h"
+#include "parameters.h"
+#include "can_bus.h"
+#include "can_health.h"
+#include "first_fault.h"
+#include "fault_log.h"
+#include "igbt_thermal.h"
+#include "temp_slope.h"
+#include "dew_point.h"
+#include "plausibility.h"
 
 #include <iib_modules/fap.h>
 #include <iib_modules/fac_os.h>
@@ -64,29 +76,22 @@ bool InterlockAlarmCheckTask = 0;
 bool DriverVoltReadTask      = 0;
 bool Driver1CurrtReadTask    = 0;
 bool Driver2CurrtReadTask    = 0;
-bool SendCanDataTask         = 0;
 bool StartNtcTask            = 0;
 bool NtcReadTask             = 0;
+bool TelemetryTask           = 0;
+bool CaptureTask             = 0;
+bool CanHealthTask           = 0;
+bool FirstFaultTask          = 0;
+bool FaultLogTask            = 0;
+bool TempSlopeTask           = 0;
+bool DewPointTask            = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void ErrorCheckHandle(void)
 {
-    if(Pt100Ch1ErrorRead()) Pt100Ch1Clear();
-    if(Pt100Ch2ErrorRead()) Pt100Ch2Clear();
-    if(Pt100Ch3ErrorRead()) Pt100Ch3Clear();
-    if(Pt100Ch4ErrorRead()) Pt100Ch4Clear();
-
-    // Check CanNotCommunicate
-    // Indicate channel problem, need a PT100 initialization or a chip verification
-    // Reset() -> Reset implemented by software
-
-    // Check RTD Out Of Range
-    // send a command to indication layer to signalize the user
-    if(Pt100Ch1RtdStatusRead()) Pt100Ch1Reset();
-    if(Pt100Ch2RtdStatusRead()) Pt100Ch2Reset();
-    if(Pt100Ch3RtdStatusRead()) Pt100Ch3Reset();
-    if(Pt100Ch4RtdStatusRead()) Pt100Ch4Reset();
+    // Clear das falhas isoladas, reinicializacao com backoff dos canais falhos
+    Pt100HealthCheck();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -143,8 +148,12 @@ void task_100_us(void)
 
 #if (CurrentCh1Enable == 1)
 
+        PROFILE_START(PROFILE_CURRENT_SAMPLE);
+
         CurrentCh1Sample();
 
+        PROFILE_STOP(PROFILE_CURRENT_SAMPLE);
+
 #endif
 
     }
@@ -229,6 +238,35 @@ void task_1_ms(void)
     }
     else _8Hz++;
 
+    // Publicacao de telemetria por periodo e mudanca de valor, avaliada a cada 1ms
+    TelemetryTask = 1;
+
+#if (IgbtThermalEnable == 1)
+
+    // Modelo termico da juncao dos IGBTs, passo fixo de 1ms
+    IgbtThermalSample();
+
+#endif
+
+#if (PlausibilityEnable == 1)
+
+    // Regras de plausibilidade entre medidas redundantes
+    PlausibilitySample();
+
+#endif
+
+    // Comandos e transferencia da captura pos-interlock, um quadro por 1ms
+    CaptureTask = 1;
+
+    // Supervisao do barramento CAN e publicacao dos contadores
+    CanHealthTask = 1;
+
+    // Publicacao do registro de primeira falha, um quadro por 1ms
+    FirstFaultTask = 1;
+
+    // Gravacao do log de eventos na EEPROM, uma palavra por 1ms
+    FaultLogTask = 1;
+
     // Timestamp for 1ms tasks
     if(mSecond >= 1000)
     {
@@ -236,14 +274,18 @@ void task_1_ms(void)
     }
     else mSecond++;
 
+#if (AdcInjectEnable == 1)
+
+    // O replay comeca sempre no inicio do ciclo das tarefas de 1s e da
+    // rotacao dos canais: a proxima interrupcao de 100us roda o slot 0
+    if(mSecond == 0 && CaptureReplaySync()) uSecond = 10;
+
+#endif
+
     // Trigger for 1s period tasks (no critical tasks)
     switch(mSecond)
     {
 
-    case 20:
-    	SendCanDataTask = 1;        	// 80ms
-    	break;
-
     case 100:
     	TempPt100Ch1ReadTask = 1;   	// 100ms
     	break;
@@ -296,6 +338,10 @@ void task_1_ms(void)
     	RhReadTask = 1;					// 100ms
     	break;
 
+    case 800:
+    	DewPointTask = 1;				// apos a leitura de umidade
+    	break;
+
     case 860:
     	ErrorCheckTask = 1;				// 40ms
     	break;
@@ -304,6 +350,10 @@ void task_1_ms(void)
     	InterlockAlarmCheckTask = 1;	// 100ms
     	break;
 
+    case 950:
+    	TempSlopeTask = 1;				// apos todas as leituras de temperatura
+    	break;
+
     case 1000:
 
     	break;
@@ -526,6 +576,34 @@ void BoardTask(void)
       InterlockAlarmCheckTask = 0;
   }
 
+//*******************************************************************************************
+
+  else if(DewPointTask)
+  {
+
+#if (DewPointEnable == 1)
+
+      DewPointUpdate();
+
+#endif
+
+      DewPointTask = 0;
+  }
+
+//*******************************************************************************************
+
+  else if(TempSlopeTask)
+  {
+
+#if (TempSlopeEnable == 1)
+
+      TempSlopeUpdate();
+
+#endif
+
+      TempSlopeTask = 0;
+  }
+
 //*******************************************************************************************
 
   else if(LedUpdateTask)
@@ -537,23 +615,61 @@ void BoardTask(void)
 
 //*******************************************************************************************
 
-  else if (SendCanDataTask)
+  else if (TelemetryTask)
   {
-	  // Usado para testes com leituras rapidas.
+      TelemetrySchedule();
 
-#if (Fast_CAN == 0)
+      TelemetryTask = 0;
+  }
 
-	  send_data_schedule();
+//*******************************************************************************************
 
-#endif
+  else if (CaptureTask)
+  {
+      CaptureTransfer();
 
-      SendCanDataTask = 0;
+      CaptureTask = 0;
+  }
+
+//*******************************************************************************************
+
+  else if (CanHealthTask)
+  {
+      CanHealthService();
+
+      CanHealthTask = 0;
+  }
+
+//*******************************************************************************************
+
+  else if (FirstFaultTask)
+  {
+      FirstFaultService();
+
+      FirstFaultTask = 0;
+  }
+
+//*******************************************************************************************
+
+  else if (FaultLogTask)
+  {
+      FaultLogService();
+
+      FaultLogTask = 0;
   }
 
 //*******************************************************************************************
 
   power_on_check();
 
+//*******************************************************************************************
+
+  // Comandos recebidos pelo CAN, copiados na interrupcao
+  can_rx_dispatch();
+
+  // Requisicoes de parametros recebidas pelo CAN
+  ParamService();
+
 //*******************************************************************************************
 
 }
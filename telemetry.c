@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file telemetry.c
+ * @brief Rate scheduled publisher for the iib_signals telemetry.
+ *
+ * TelemetrySchedule() runs once per millisecond in the main loop and sends at
+ * most one data frame per call, and none while the previous one is still
+ * queued, so the single TX message object is never overwritten. Forced and changed
+ * signals are served first, then the most overdue one; a periodic signal late
+ * by a whole period or more wins over them, so a noisy signal outside its
+ * deadband cannot starve the others. The due times start
+ * staggered by one millisecond per signal, so signals with the same period
+ * never compete for the same slot.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "telemetry.h"
+#include "iib_data.h"
+#include "can_bus.h"
+#include "can_health.h"
+#include "peripheral_drivers/timer/timer.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Um quadro custa 1000 fichas; o balde ganha TELEMETRY_BUDGET_FPS fichas por ms
+#define TELEMETRY_FRAME_COST        1000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static const telemetry_signal_cfg_t *signal_cfg = 0;
+
+static uint8_t signal_count = 0;
+
+static uint8_t next_signal = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static float    last_sent[NUM_MAX_IIB_SIGNALS];
+static uint32_t next_due[NUM_MAX_IIB_SIGNALS];
+
+// Um bit por sinal que deve ser enviado no proximo slot livre
+static volatile uint32_t force_send = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t budget_tokens = 0;
+static uint32_t budget_ms = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#if (TelemetryCovEnable == 1)
+
+static bool telemetry_changed(uint8_t var)
+{
+    float value = g_controller_iib.iib_signals[var].f;
+    float delta = value - last_sent[var];
+    float reference = last_sent[var];
+    float deadband;
+
+    if(delta < 0.0) delta = -delta;
+    if(reference < 0.0) reference = -reference;
+
+    // O maior dos dois limites vale: o absoluto evita trafego perto de zero
+    deadband = signal_cfg[var].DeadbandRel * reference;
+    if(deadband < signal_cfg[var].DeadbandAbs) deadband = signal_cfg[var].DeadbandAbs;
+
+    return (delta > deadband);
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void telemetry_send(uint8_t var, uint32_t now, bool periodic)
+{
+    // O quadro anterior ainda nao saiu: o sinal continua pendente e o slot nao e gasto
+    if(CanHealthTxBusy(MESSAGE_DATA_IIB_OBJ_ID)) return;
+
+    last_sent[var] = g_controller_iib.iib_signals[var].f;
+
+    // No envio periodico o proximo prazo nao acumula atraso; se ja passou, recomeca
+    if(periodic)
+    {
+        next_due[var] += signal_cfg[var].Period_ms;
+        if((int32_t)(now - next_due[var]) >= 0) next_due[var] = now + signal_cfg[var].Period_ms;
+    }
+    else next_due[var] = now + signal_cfg[var].Period_ms;
+
+    force_send &= ~((uint32_t)1 << var);
+
+    budget_tokens -= TELEMETRY_FRAME_COST;
+
+    send_data_message(var);
+
+    next_signal = var + 1;
+    if(next_signal >= signal_count) next_signal = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TelemetryInit(const telemetry_signal_cfg_t *cfg, uint8_t num_signals)
+{
+    uint8_t i;
+    uint32_t now = get_millis();
+
+    if(num_signals > NUM_MAX_IIB_SIGNALS) num_signals = NUM_MAX_IIB_SIGNALS;
+
+    for(i = 0; i < NUM_MAX_IIB_SIGNALS; i++)
+    {
+        last_sent[i] = 0.0;
+        next_due[i] = now + i;
+    }
+
+    signal_cfg = cfg;
+    signal_count = num_signals;
+    next_signal = 0;
+
+    budget_tokens = TELEMETRY_BUDGET_BURST * TELEMETRY_FRAME_COST;
+    budget_ms = now;
+
+    // Envia todos os sinais uma vez apos a inicializacao
+    if(num_signals >= 32) force_send = 0xFFFFFFFF;
+    else force_send = ((uint32_t)1 << num_signals) - 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TelemetryForceSend(uint8_t var)
+{
+    if(var < signal_count) force_send |= ((uint32_t)1 << var);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TelemetrySchedule(void)
+{
+    uint8_t i;
+    uint8_t var;
+    uint8_t due = NUM_MAX_IIB_SIGNALS;
+    uint8_t event = NUM_MAX_IIB_SIGNALS;
+    int32_t late;
+    int32_t most_late = -1;
+    uint32_t now;
+
+    if(signal_count == 0) return;
+
+    now = get_millis();
+
+    budget_tokens += (now - budget_ms) * TELEMETRY_BUDGET_FPS;
+    if(budget_tokens > TELEMETRY_BUDGET_BURST * TELEMETRY_FRAME_COST)
+    {
+        budget_tokens = TELEMETRY_BUDGET_BURST * TELEMETRY_FRAME_COST;
+    }
+    budget_ms = now;
+
+    if(budget_tokens < TELEMETRY_FRAME_COST) return;
+
+    var = next_signal;
+
+    for(i = 0; i < signal_count; i++)
+    {
+        if(event == NUM_MAX_IIB_SIGNALS && (force_send & ((uint32_t)1 << var))) event = var;
+
+#if (TelemetryCovEnable == 1)
+
+        else if(event == NUM_MAX_IIB_SIGNALS && telemetry_changed(var)) event = var;
+
+#endif
+
+        late = (int32_t)(now - next_due[var]);
+
+        if(late > most_late)
+        {
+            most_late = late;
+            due = var;
+        }
+
+        var++;
+        if(var >= signal_count) var = 0;
+    }
+
+    // Atrasado um periodo inteiro: passa na frente dos envios por evento
+    if(due != NUM_MAX_IIB_SIGNALS && most_late >= (int32_t)signal_cfg[due].Period_ms) telemetry_send(due, now, 1);
+
+    else if(event != NUM_MAX_IIB_SIGNALS) telemetry_send(event, now, 0);
+
+    else if(due != NUM_MAX_IIB_SIGNALS) telemetry_send(due, now, 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
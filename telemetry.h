@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file telemetry.h
+ * @brief Rate scheduled publisher for the iib_signals telemetry.
+ *
+ * Each signal is sent on MESSAGE_DATA_IIB once per its own period. With
+ * TelemetryCovEnable it is also sent early when it leaves its deadband around
+ * the last transmitted value. A token bucket keeps the total frame rate under
+ * TELEMETRY_BUDGET_FPS, sized so that a full rack of TELEMETRY_RACK_BOARDS
+ * boards stays under TELEMETRY_RACK_FPS on the shared bus. The periods of the
+ * module tables add up to at most 12 frames/s (FAP); the rest of the budget is
+ * left for the early sends of changed signals.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1: sinais fora do deadband sao enviados antes do fim do periodo
+#define TelemetryCovEnable                      1
+
+// Rack cheio: todos os enderecos de 5 bits (1 a 31) no mesmo barramento de 1 Mbit/s
+#define TELEMETRY_RACK_BOARDS                   31
+
+// Quadros de telemetria por segundo do rack inteiro, cerca de 8% do barramento
+#define TELEMETRY_RACK_FPS                      620
+
+// Limite de quadros de telemetria por segundo de cada placa e rajada maxima
+#define TELEMETRY_BUDGET_FPS                    (TELEMETRY_RACK_FPS / TELEMETRY_RACK_BOARDS)
+#define TELEMETRY_BUDGET_BURST                  4
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    float       DeadbandAbs;    // Deadband absoluto, na unidade do sinal
+    float       DeadbandRel;    // Deadband relativo ao ultimo valor enviado (0.01 = 1%)
+    uint16_t    Period_ms;      // Periodo de envio
+} telemetry_signal_cfg_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void TelemetryInit(const telemetry_signal_cfg_t *cfg, uint8_t num_signals);
+extern void TelemetrySchedule(void);
+extern void TelemetryForceSend(uint8_t var);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* TELEMETRY_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,288 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file temp_slope.c
+ * @brief Rate-of-rise (dT/dt) alarms of the temperature channels.
+ *
+ * The samples are kept in centi-degrees in a fixed ring per channel, with the
+ * sums Sy = sum(y) and Sxy = sum(x * y), x = 0 for the oldest sample. When the
+ * window slides every x drops by one, so a new sample costs
+ *
+ *   Sxy' = Sxy - (Sy - y_old) + (n - 1) * y_new,  Sy' = Sy - y_old + y_new
+ *
+ * and the slope is (n * Sxy - Sx * Sy) / (n^2 * (n^2 - 1) / 12), with
+ * Sx = n * (n - 1) / 2. The sums are integers, so they never drift.
+ *
+ * A reading is limited to +-TEMP_SLOPE_RANGE_C before the conversion, which
+ * keeps Sxy of a full window inside int32_t; a NaN (open sensor) repeats the
+ * previous sample of the channel, adding no slope. A PT100 outside
+ * PT100_HEALTH_OK also repeats its previous sample, and its slope stays at 0
+ * until a whole window of healthy samples has come in.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "temp_slope.h"
+#include "pt100.h"
+#include "ntc_isolated_i2c.h"
+#include "BoardTempHum.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Amostras em centesimos de grau, uma por segundo: inclinacao em degC/min
+#define TEMP_SLOPE_SCALE                        (60.0 / 100.0)
+
+// Faixa aceita antes da conversao para inteiro
+#define TEMP_SLOPE_RANGE_C                      1000.0
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+temp_slope_t TempSlope[TEMP_SLOPE_NUM_CHANNELS];
+
+unsigned int TempSlopeWindow_s = TEMP_SLOPE_WINDOW_S;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static float (* const source[TEMP_SLOPE_NUM_CHANNELS])(void) =
+{
+    Pt100Ch1Read, Pt100Ch2Read, Pt100Ch3Read, Pt100Ch4Read,
+    TempIgbt1Read, TempIgbt2Read,
+    BoardTempRead
+};
+
+// Saude dos PT100; os demais canais nao tem esse estado
+static unsigned char (* const source_health[TEMP_SLOPE_NUM_CHANNELS])(void) =
+{
+    Pt100Ch1HealthRead, Pt100Ch2HealthRead, Pt100Ch3HealthRead, Pt100Ch4HealthRead,
+    0, 0,
+    0
+};
+
+static int32_t  ring[TEMP_SLOPE_NUM_CHANNELS][TEMP_SLOPE_MAX_WINDOW];
+static int32_t  sum_y[TEMP_SLOPE_NUM_CHANNELS];
+static int32_t  sum_xy[TEMP_SLOPE_NUM_CHANNELS];
+static int32_t  last_y[TEMP_SLOPE_NUM_CHANNELS];
+
+// Amostras seguidas com o PT100 em PT100_HEALTH_OK
+static uint8_t  good[TEMP_SLOPE_NUM_CHANNELS];
+
+static uint8_t  head = 0;
+static uint8_t  count = 0;
+static uint8_t  window = 0;
+
+// Ultimo valor do parametro aplicado
+static unsigned int window_param = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void temp_slope_reset(void)
+{
+    uint8_t i;
+
+    window_param = TempSlopeWindow_s;
+
+    window = TEMP_SLOPE_MAX_WINDOW;
+    if(window_param < TEMP_SLOPE_MAX_WINDOW) window = window_param;
+
+    head = 0;
+    count = 0;
+
+    for(i = 0; i < TEMP_SLOPE_NUM_CHANNELS; i++)
+    {
+        sum_y[i] = 0;
+        sum_xy[i] = 0;
+        last_y[i] = 0;
+        good[i] = 0;
+        TempSlope[i].Value = 0.0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void temp_slope_check(temp_slope_t *s)
+{
+    if(s->AlarmLimit > 0.0 && s->Value > s->AlarmLimit)
+    {
+        if(s->Alarm_DelayCount < s->Alarm_Delay_ms) s->Alarm_DelayCount++;
+        else
+        {
+           s->Alarm_DelayCount = 0;
+           s->Alarm = 1;
+        }
+    }
+    else s->Alarm_DelayCount = 0;
+
+    if(s->TripLimit > 0.0 && s->Value > s->TripLimit)
+    {
+        if(s->Itlk_DelayCount < s->Itlk_Delay_ms) s->Itlk_DelayCount++;
+        else
+        {
+           s->Itlk_DelayCount = 0;
+           s->Trip = 1;
+        }
+    }
+    else s->Itlk_DelayCount = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TempSlopeInit(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < TEMP_SLOPE_NUM_CHANNELS; i++)
+    {
+        TempSlope[i].AlarmLimit = TEMP_SLOPE_ALM_LIM;
+        TempSlope[i].TripLimit = TEMP_SLOPE_ITLK_LIM;
+        TempSlope[i].Alarm = 0;
+        TempSlope[i].Trip = 0;
+        TempSlope[i].Alarm_Delay_ms = TEMP_SLOPE_DELAY;
+        TempSlope[i].Alarm_DelayCount = 0;
+        TempSlope[i].Itlk_Delay_ms = TEMP_SLOPE_DELAY;
+        TempSlope[i].Itlk_DelayCount = 0;
+    }
+
+    temp_slope_reset();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TempSlopeUpdate(void)
+{
+    uint8_t i;
+    int32_t y;
+    int32_t y_old;
+    int32_t n;
+    int64_t num;
+    float value;
+    bool stale;
+
+    // Janela alterada pelos parametros: recomeca com a memoria limpa
+    if(window_param != TempSlopeWindow_s) temp_slope_reset();
+
+    if(window < 2) return;
+
+    n = (count < window) ? count + 1 : window;
+
+    for(i = 0; i < TEMP_SLOPE_NUM_CHANNELS; i++)
+    {
+        value = source[i]();
+        stale = source_health[i] && source_health[i]() != PT100_HEALTH_OK;
+
+        if(stale) good[i] = 0;
+        else if(good[i] < TEMP_SLOPE_MAX_WINDOW) good[i]++;
+
+        // NaN ou PT100 fora de OK repete a amostra anterior; +-Inf e valores fora da faixa sao limitados
+        if(stale || value != value) y = last_y[i];
+        else
+        {
+            if(value > TEMP_SLOPE_RANGE_C) value = TEMP_SLOPE_RANGE_C;
+            else if(value < -TEMP_SLOPE_RANGE_C) value = -TEMP_SLOPE_RANGE_C;
+
+            value *= 100.0;
+            y = (int32_t)(value >= 0.0 ? value + 0.5 : value - 0.5);
+        }
+
+        last_y[i] = y;
+
+        if(count < window)
+        {
+            sum_xy[i] += count * y;
+            sum_y[i] += y;
+        }
+        else
+        {
+            y_old = ring[i][head];
+
+            sum_xy[i] += (n - 1) * y - (sum_y[i] - y_old);
+            sum_y[i] += y - y_old;
+        }
+
+        ring[i][head] = y;
+
+        if(n < TEMP_SLOPE_MIN_SAMPLES) continue;
+
+        // Janela ainda com amostras repetidas de um PT100 fora de OK
+        if(good[i] < n)
+        {
+            TempSlope[i].Value = 0.0;
+            TempSlope[i].Alarm_DelayCount = 0;
+            TempSlope[i].Itlk_DelayCount = 0;
+            continue;
+        }
+
+        num = (int64_t)n * sum_xy[i] - (int64_t)(n * (n - 1) / 2) * sum_y[i];
+
+        TempSlope[i].Value = (float)num * 12.0 / ((float)(n * n) * (float)(n * n - 1)) * TEMP_SLOPE_SCALE;
+
+        temp_slope_check(&TempSlope[i]);
+    }
+
+    if(++head >= window) head = 0;
+    if(count < window) count++;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float TempSlopeRead(temp_slope_channel_t ch)
+{
+    if(ch >= TEMP_SLOPE_NUM_CHANNELS) return 0.0;
+
+    return TempSlope[ch].Value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char TempSlopeAlarmStatusRead(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < TEMP_SLOPE_NUM_CHANNELS; i++)
+    {
+        if(TempSlope[i].Alarm) return 1;
+    }
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char TempSlopeTripStatusRead(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < TEMP_SLOPE_NUM_CHANNELS; i++)
+    {
+        if(TempSlope[i].Trip) return 1;
+    }
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TempSlopeClearAlarmTrip(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < TEMP_SLOPE_NUM_CHANNELS; i++)
+    {
+        TempSlope[i].Alarm = 0;
+        TempSlope[i].Trip = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
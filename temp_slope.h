@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file temp_slope.h
+ * @brief Rate-of-rise (dT/dt) alarms of the temperature channels.
+ *
+ * Every temperature channel (PT100 1..4, IGBT NTCs 1..2, board) is sampled
+ * once per cycle of the 1s tasks, after all of them were read, and a least
+ * squares line is fitted over the last TempSlopeWindow_s samples. The slope,
+ * in degC/min, goes through the same alarm / trip check with delay count as
+ * the level of the channel; the delays count slope updates, i.e. seconds.
+ *
+ * Only a rising temperature alarms. A limit of 0 disables the check: by
+ * default only the alarm is armed, the interlock is left for commissioning.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TEMP_SLOPE_H_
+#define TEMP_SLOPE_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define TempSlopeEnable                         1
+
+// Janela em amostras de 1s; a memoria e fixa para a maior janela
+#define TEMP_SLOPE_WINDOW_S                     30
+#define TEMP_SLOPE_MAX_WINDOW                   64
+
+// Amostras minimas antes de avaliar a inclinacao
+#define TEMP_SLOPE_MIN_SAMPLES                  8
+
+// Limites padrao em degC/min (0 = desligado)
+#define TEMP_SLOPE_ALM_LIM                      5.0
+#define TEMP_SLOPE_ITLK_LIM                     0.0
+#define TEMP_SLOPE_DELAY                        3
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    TEMP_SLOPE_PT100_CH1 = 0,
+    TEMP_SLOPE_PT100_CH2,
+    TEMP_SLOPE_PT100_CH3,
+    TEMP_SLOPE_PT100_CH4,
+    TEMP_SLOPE_NTC_IGBT1,
+    TEMP_SLOPE_NTC_IGBT2,
+    TEMP_SLOPE_BOARD,
+    TEMP_SLOPE_NUM_CHANNELS
+}temp_slope_channel_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    float Value;                  // degC/min
+    float AlarmLimit;
+    float TripLimit;
+    unsigned char Alarm;
+    unsigned char Trip;
+    unsigned int  Alarm_Delay_ms; // atualizacoes de 1s
+    unsigned int  Alarm_DelayCount;
+    unsigned int  Itlk_Delay_ms;  // atualizacoes de 1s
+    unsigned int  Itlk_DelayCount;
+}temp_slope_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern temp_slope_t TempSlope[TEMP_SLOPE_NUM_CHANNELS];
+
+// Janela em amostras, ajustavel pelo servico de parametros
+extern unsigned int TempSlopeWindow_s;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void TempSlopeInit(void);
+extern void TempSlopeUpdate(void);
+extern float TempSlopeRead(temp_slope_channel_t ch);
+extern unsigned char TempSlopeAlarmStatusRead(void);
+extern unsigned char TempSlopeTripStatusRead(void);
+extern void TempSlopeClearAlarmTrip(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* TEMP_SLOPE_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file trip_latency.c
+ * @brief Interlock trip latency measurement on the bench.
+ *
+ * TripLatencyStep() and TripLatencyTripCheck() run in the 1ms interrupt and
+ * TripLatencyFrameSent() in can_isr(), all at priority 1; TripLatencyRelayOff()
+ * runs in the main loop. An edge while the module is already interlocked does
+ * not arm, and a new edge before the trip restarts the measurement. Relays or
+ * a frame caused by another channel do not complete it.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/interrupt.h"
+#include "trip_latency.h"
+#include "application.h"
+#include "adc_internal.h"
+#include "peripheral_drivers/timer/timer.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern unsigned int mSecond;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile bool armed = 0;
+static volatile bool trip_done = 0;
+static volatile bool relay_done = 0;
+static volatile bool frame_done = 0;
+
+static volatile uint8_t  step_ch = 0;
+static volatile uint32_t step_us = 0;
+static volatile uint32_t trip_us = 0;
+static volatile uint32_t trip_budget_us = 0;
+static volatile uint32_t budget_us = 0;
+
+static volatile uint32_t trip_latency = 0;
+static volatile uint32_t relay_latency = 0;
+static volatile uint32_t frame_latency = 0;
+
+static volatile uint32_t pass_count = 0;
+static volatile uint32_t fail_count = 0;
+
+static volatile trip_latency_state_t result = TRIP_LATENCY_IDLE;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void trip_latency_finish(void)
+{
+    uint32_t worst;
+
+    if(!trip_done || !relay_done || !frame_done) return;
+
+    armed = 0;
+
+    worst = (relay_latency > frame_latency) ? relay_latency : frame_latency;
+
+    if(trip_latency <= trip_budget_us && worst <= budget_us)
+    {
+        pass_count++;
+        result = TRIP_LATENCY_PASS;
+    }
+    else
+    {
+        fail_count++;
+        result = TRIP_LATENCY_FAIL;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TripLatencyStep(unsigned char ch, unsigned int itlk_delay)
+{
+    if(InterlockRead()) return;
+
+    step_us = get_micros();
+    step_ch = ch;
+
+    // Ate uma amostra de fase, o debounce e a amostra que seta o trip
+    trip_budget_us = (itlk_delay + 2) * TRIP_LATENCY_SAMPLE_US + TRIP_LATENCY_POLL_US;
+
+    trip_done = 0;
+    relay_done = 0;
+    frame_done = 0;
+    armed = 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TripLatencyTripCheck(void)
+{
+    adc_t *adc;
+    uint32_t wait_ms;
+
+    if(!armed || trip_done) return;
+
+    adc = AdcInputChannel(step_ch);
+
+    if(adc == 0 || !adc->Trip) return;
+
+    trip_us = get_micros();
+    trip_latency = trip_us - step_us;
+
+    // Reles e quadro saem no proximo InterlockAlarmCheckTask, estritamente
+    // depois deste ms (o do ms atual pode ja ter rodado)
+    wait_ms = (TRIP_LATENCY_CHECK_MS + TRIP_LATENCY_CYCLE_MS - 1 - mSecond) % TRIP_LATENCY_CYCLE_MS + 1;
+
+    budget_us = wait_ms * 1000 + TRIP_LATENCY_LOOP_US;
+
+    trip_done = 1;
+
+    trip_latency_finish();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TripLatencyRelayOff(void)
+{
+    // A verificacao agendada pode rodar antes da leitura de 1ms da flag
+    if(!trip_done)
+    {
+        IntMasterDisable();
+        TripLatencyTripCheck();
+        IntMasterEnable();
+    }
+
+    if(!armed || !trip_done || relay_done) return;
+
+    relay_latency = get_micros() - trip_us;
+    relay_done = 1;
+
+    trip_latency_finish();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+void TripLatencyFrameSent(void)
+{
+    // A resposta ao reset tambem usa o objeto de interlock
+    if(!armed || frame_done || !InterlockRead()) return;
+
+    TripLatencyTripCheck();
+
+    if(!trip_done) return;
+
+    frame_latency = get_micros() - trip_us;
+    frame_done = 1;
+
+    trip_latency_finish();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+trip_latency_state_t TripLatencyState(void)
+{
+    if(!armed) return result;
+
+    if(!trip_done)
+    {
+        if((get_micros() - step_us) > trip_budget_us) return TRIP_LATENCY_TIMEOUT;
+    }
+    else if((get_micros() - trip_us) > budget_us) return TRIP_LATENCY_TIMEOUT;
+
+    return TRIP_LATENCY_PENDING;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TripLatencyRead(trip_latency_item_t item)
+{
+    switch(item)
+    {
+    case TRIP_LATENCY_RELAY_US:
+        return relay_latency;
+
+    case TRIP_LATENCY_FRAME_US:
+        return frame_latency;
+
+    case TRIP_LATENCY_BUDGET_US:
+        return budget_us;
+
+    case TRIP_LATENCY_CHANNEL:
+        return step_ch;
+
+    case TRIP_LATENCY_PASS_COUNT:
+        return pass_count;
+
+    case TRIP_LATENCY_FAIL_COUNT:
+        return fail_count;
+
+    case TRIP_LATENCY_ELAPSED_US:
+        return get_micros() - step_us;
+
+    case TRIP_LATENCY_TRIP_US:
+        return trip_latency;
+
+    case TRIP_LATENCY_TRIP_BUDGET_US:
+        return trip_budget_us;
+
+    default:
+        return 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
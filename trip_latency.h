@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright (C) 2017 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file trip_latency.h
+ * @brief Interlock trip latency measurement on the bench.
+ *
+ * An edge of an injected ADC waveform (AdcInjectEnable) arms a measurement,
+ * taken in two segments with their own budgets:
+ *
+ *   step -> trip flag of the stepped channel: debounce of the channel, one
+ *           sample of phase and the 1ms poll of the flag
+ *   trip flag -> relays released and interlock frame sent: time left to the
+ *           next InterlockAlarmCheckTask slot plus TRIP_LATENCY_LOOP_US
+ *
+ * so a debounce set longer than the channel asks for fails the first
+ * segment instead of hiding under the wait for the scheduled check.
+ *
+ * @date 19 de out de 2026
+ *
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRIP_LATENCY_H_
+#define TRIP_LATENCY_H_
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Intervalo entre amostras de um canal em task_100_us() (11 x 100us)
+#define TRIP_LATENCY_SAMPLE_US                  1100
+
+// A flag de trip do canal e lida na interrupcao de 1ms
+#define TRIP_LATENCY_POLL_US                    1000
+
+// Ciclo das tarefas de 1s em task_1_ms() e slot do InterlockAlarmCheckTask
+#define TRIP_LATENCY_CYCLE_MS                   1001
+#define TRIP_LATENCY_CHECK_MS                   900
+
+// Tarefas do mesmo ms a frente no laco principal e a fila do CAN
+#define TRIP_LATENCY_LOOP_US                    5000
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    TRIP_LATENCY_IDLE = 0,      // nenhuma medicao desde o boot
+    TRIP_LATENCY_PENDING,       // degrau aplicado, aguardando o interlock
+    TRIP_LATENCY_PASS,          // ultima medicao dentro do orcamento
+    TRIP_LATENCY_FAIL,          // ultima medicao acima do orcamento
+    TRIP_LATENCY_TIMEOUT        // degrau aplicado e orcamento esgotado sem interlock
+}trip_latency_state_t;
+
+typedef enum {
+    TRIP_LATENCY_RELAY_US = 0,  // flag de trip ate o desligamento dos reles
+    TRIP_LATENCY_FRAME_US,      // flag de trip ate o quadro de interlock transmitido
+    TRIP_LATENCY_BUDGET_US,     // orcamento de reles e quadro a partir da flag
+    TRIP_LATENCY_CHANNEL,       // canal do degrau (ordem de adc_0_value[] e adc_1_value[])
+    TRIP_LATENCY_PASS_COUNT,
+    TRIP_LATENCY_FAIL_COUNT,
+    TRIP_LATENCY_ELAPSED_US,    // tempo desde o ultimo degrau
+    TRIP_LATENCY_TRIP_US,       // degrau ate a flag de trip do canal
+    TRIP_LATENCY_TRIP_BUDGET_US,// orcamento do debounce do canal
+    TRIP_LATENCY_NUM_ITEMS
+}trip_latency_item_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void TripLatencyStep(unsigned char ch, unsigned int itlk_delay);
+extern void TripLatencyTripCheck(void);
+extern void TripLatencyRelayOff(void);
+extern void TripLatencyFrameSent(void);
+extern trip_latency_state_t TripLatencyState(void);
+extern uint32_t TripLatencyRead(trip_latency_item_t item);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif /* TRIP_LATENCY_H_ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////